@@ -0,0 +1,181 @@
+#include "autocorrect.h"
+
+#ifndef AUTOCORRECT_DATA
+#define AUTOCORRECT_DATA "autocorrect_data.h"
+#endif
+#include AUTOCORRECT_DATA
+
+/* Trie format
+ *
+ * Typos are stored reversed, as keycodes, with KC_SPC for a word boundary.
+ * A node is one of:
+ *   leaf    0x80 | let_key_through << 6 | backspaces, then the keycodes to
+ *           type, 0 terminated
+ *   branch  0x40, then {keycode, child offset lo, hi} entries, 0 terminated
+ *   chain   keycodes to match in order, 0 terminated, next node follows
+ */
+
+#define NODE_LEAF 0x80
+#define NODE_PASS 0x40
+#define NODE_BRANCH 0x40
+#define LEAF_BACKSPACES 0x3F
+
+#define BOUNDARY KC_SPC
+
+#ifndef DISABLE_LEADER
+extern bool leading;
+#endif
+
+static uint8_t buffer[AUTOCORRECT_MAX_LENGTH];
+static uint8_t buffer_len;
+
+static void reset(void)
+{
+  buffer[0] = BOUNDARY;
+  buffer_len = 1;
+}
+
+static void push(uint8_t code)
+{
+  if (buffer_len == AUTOCORRECT_MAX_LENGTH)
+  {
+    memmove(buffer, buffer + 1, --buffer_len);
+  }
+  buffer[buffer_len++] = code;
+}
+
+static void tap(uint8_t code)
+{
+  register_code(code);
+  unregister_code(code);
+}
+
+// Offset of the matching leaf, or 0
+static uint16_t find_correction(void)
+{
+  uint16_t node = 0;
+  int8_t i = buffer_len - 1;
+
+  for (;;)
+  {
+    uint8_t b = pgm_read_byte(autocorrect_data + node);
+    if (b & NODE_LEAF)
+    {
+      return node;
+    }
+    if (b == NODE_BRANCH)
+    {
+      if (i < 0)
+      {
+        return 0;
+      }
+      uint8_t want = buffer[i--];
+      for (node++; (b = pgm_read_byte(autocorrect_data + node)) != want; node += 3)
+      {
+        if (!b)
+        {
+          return 0;
+        }
+      }
+      node = pgm_read_word(autocorrect_data + node + 1);
+    }
+    else
+    {
+      for (; b; b = pgm_read_byte(autocorrect_data + ++node))
+      {
+        if (i < 0 || buffer[i--] != b)
+        {
+          return 0;
+        }
+      }
+      node++;
+    }
+  }
+}
+
+// Returns the buffer code for keycode, 0 for keys that don't touch it
+static uint8_t classify(uint16_t keycode)
+{
+  switch (keycode)
+  {
+  case KC_A ... KC_Z:
+  case KC_QUOT:
+    return keycode;
+  case KC_1 ... KC_0:
+  case KC_ENT:
+  case KC_TAB:
+  case KC_SPC ... KC_SCLN:
+  case KC_GRV ... KC_SLSH:
+  case QK_TAP_DANCE ... QK_TAP_DANCE_MAX:
+    return BOUNDARY;
+  case KC_NO ... KC_UNDEFINED: // lets_split's layer keys are 0-3
+  case KC_LCTRL ... KC_RGUI:
+  case QK_TO ... QK_ONE_SHOT_MOD_MAX:
+  case QK_LAYER_TAP_TOGGLE ... QK_LAYER_TAP_TOGGLE_MAX:
+    return 0;
+  }
+  reset();
+  return 0;
+}
+
+bool autocorrect_key(uint16_t keycode)
+{
+  uint8_t code;
+
+  if (!buffer_len)
+  {
+    reset();
+  }
+  if ((get_mods() | get_oneshot_mods()) & ~(MOD_BIT(KC_LSFT) | MOD_BIT(KC_RSFT)))
+  {
+    // A shortcut, not typing
+    reset();
+    return true;
+  }
+#ifndef DISABLE_LEADER
+  if (leading)
+  {
+    reset();
+    return true;
+  }
+#endif
+  if (keycode == KC_BSPC)
+  {
+    if (buffer_len > 1)
+    {
+      buffer_len--;
+    }
+    return true;
+  }
+  if (!(code = classify(keycode)))
+  {
+    return true;
+  }
+
+  push(code);
+  uint16_t leaf = find_correction();
+  if (!leaf)
+  {
+    return true;
+  }
+
+  uint8_t head = pgm_read_byte(autocorrect_data + leaf);
+  bool pass = head & NODE_PASS;
+  uint8_t backspaces = head & LEAF_BACKSPACES;
+
+  buffer_len -= 1 + backspaces;
+  for (uint8_t i = 0; i < backspaces; i++)
+  {
+    tap(KC_BSPC);
+  }
+  for (uint16_t p = leaf + 1; (code = pgm_read_byte(autocorrect_data + p)); p++)
+  {
+    tap(code);
+    push(code);
+  }
+  if (pass)
+  {
+    push(BOUNDARY);
+  }
+  return pass;
+}
@@ -0,0 +1,20 @@
+#ifndef AUTOCORRECT_H
+#define AUTOCORRECT_H
+
+#include "quantum.h"
+
+/* Autocorrect
+ *
+ * Keeps the last few letters typed and looks them up, newest first, in the
+ * typo trie that sim/build/autocorrect_gen builds from autocorrect_dict.txt
+ * into autocorrect_data.h. On a match it backspaces the wrong part and types
+ * the fix. A lookup walks at most AUTOCORRECT_MAX_LENGTH trie nodes, however
+ * many entries the dictionary has.
+ *
+ * Call autocorrect_key() for each key press that will reach the host. It
+ * returns false when the press was replaced by a correction.
+ */
+
+bool autocorrect_key(uint16_t keycode);
+
+#endif
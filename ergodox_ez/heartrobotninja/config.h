@@ -15,4 +15,7 @@
 #undef TAPPING_TOGGLE
 #define TAPPING_TOGGLE 2
 
+// The matrix is transposed: rows 0-6 are the left hand's columns
+#define HOME_ROW_IS_RIGHT(key) ((key).row >= 7)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef EEPROM_QUEUE_H
+#define EEPROM_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Deferred EEPROM writes
+ *
+ * An AVR EEPROM write takes ~3.4ms per byte, which is several scans. Writes
+ * are parked here instead and eeq_task() drains one byte per scan, only while
+ * the EEPROM is idle. A byte that already holds its value is never rewritten.
+ *
+ * There is no queued read: QMK reads the config once at boot, before anything
+ * can be queued, and these keymaps only write it.
+ */
+
+#ifndef EEQ_SIZE
+#define EEQ_SIZE 16
+#endif
+
+void eeq_update_byte(uint8_t *addr, uint8_t value);
+void eeq_update_word(uint16_t *addr, uint16_t value);
+void eeq_update_dword(uint32_t *addr, uint32_t value);
+
+bool eeq_pending(void); // writes still queued
+void eeq_task(void);    // call once per scan
+void eeq_flush(void);   // blocking, for use before a reset
+
+// Queued equivalent of eeconfig_init()
+void eeq_config_init(void);
+
+#endif
@@ -0,0 +1,272 @@
+#include "home_row.h"
+
+#define HR_NONE 0xFF
+
+#ifndef DISABLE_LEADER
+extern bool leading;
+#endif
+
+static const uint8_t hr_codes[] = {KC_A, KC_R, KC_S, KC_T, KC_N, KC_E, KC_I, KC_O};
+static const uint8_t hr_mods[] = {
+        MOD_BIT(KC_LGUI), MOD_BIT(KC_LALT), MOD_BIT(KC_LCTL), MOD_BIT(KC_LSFT),
+        MOD_BIT(KC_LSFT), MOD_BIT(KC_LCTL), MOD_BIT(KC_LALT), MOD_BIT(KC_LGUI)};
+
+static uint8_t hr_down;   // bit per key: press was taken here
+static uint8_t hr_tapped; // bit per key: letter is down
+static uint8_t hr_held;   // bit per key: modifier is down
+static keypos_t hr_pos[8]; // where each key in hr_down was pressed
+
+static uint8_t pending = HR_NONE;
+static keypos_t pending_pos;
+static uint16_t pending_timer;
+
+/* A key on the other hand pressed while pending is undecided, held back
+ * until the overlap shows whether it's a chord or a roll
+ */
+static uint8_t other_code = KC_NO;
+static keypos_t other_pos;
+
+static bool streak;
+static uint16_t streak_timer;
+
+static uint8_t hr_index(uint16_t keycode)
+{
+  switch (keycode)
+  {
+  case KC_A:
+    return 0;
+  case KC_R:
+    return 1;
+  case KC_S:
+    return 2;
+  case KC_T:
+    return 3;
+  case KC_N:
+    return 4;
+  case KC_E:
+    return 5;
+  case KC_I:
+    return 6;
+  case KC_O:
+    return 7;
+  }
+  return HR_NONE;
+}
+
+/* Keys with nothing of their own to type: layer switches (the keymaps' own
+ * layer keys use the codes below KC_A), mouse keys and the leader
+ */
+static bool hr_silent(uint16_t keycode)
+{
+  return keycode < KC_A || IS_MOUSEKEY(keycode) || keycode == KC_LEAD ||
+         (QK_TO <= keycode && keycode <= QK_ONE_SHOT_LAYER_MAX) ||
+         (QK_LAYER_TAP_TOGGLE <= keycode && keycode <= QK_LAYER_TAP_TOGGLE_MAX);
+}
+
+/* The key down at pos, HR_NONE if none. Releases are matched by position:
+ * the keycode looked up on release comes from the layers up by then.
+ */
+static uint8_t hr_find(keypos_t pos)
+{
+  for (uint8_t i = 0; i < sizeof(hr_codes); i++)
+  {
+    if ((hr_down & (1 << i)) && hr_pos[i].row == pos.row && hr_pos[i].col == pos.col)
+    {
+      return i;
+    }
+  }
+  return HR_NONE;
+}
+
+__attribute__((weak)) bool home_row_tap_user(uint8_t keycode)
+{
+  return true;
+}
+
+static void hr_tap(uint8_t i)
+{
+  if (home_row_tap_user(hr_codes[i]))
+  {
+    register_code(hr_codes[i]);
+    hr_tapped |= 1 << i;
+  }
+}
+
+static void hr_hold(uint8_t i)
+{
+  register_mods(hr_mods[i]);
+  hr_held |= 1 << i;
+}
+
+static void mark_typed(void)
+{
+  // Keys pressed under a home row modifier are shortcuts, not typing
+  if (!hr_held)
+  {
+    streak = true;
+    streak_timer = timer_read();
+  }
+}
+
+// A home row key goes down
+static void hr_press(uint8_t i, keypos_t pos)
+{
+  hr_down |= 1 << i;
+  hr_pos[i] = pos;
+  if (streak && timer_elapsed(streak_timer) < HOME_ROW_STREAK_TERM)
+  {
+    hr_tap(i);
+    mark_typed();
+    return;
+  }
+  pending = i;
+  pending_pos = pos;
+  pending_timer = timer_read();
+}
+
+// The other-hand key held back while pending is decided goes down now
+static void release_other(void)
+{
+  uint8_t code = other_code;
+
+  if (code == KC_NO)
+  {
+    return;
+  }
+  other_code = KC_NO;
+  if (hr_index(code) != HR_NONE)
+  {
+    hr_press(hr_index(code), other_pos);
+    return;
+  }
+  if (home_row_tap_user(code))
+  {
+    register_code(code);
+  }
+  mark_typed();
+}
+
+static void resolve_tap(void)
+{
+  hr_tap(pending);
+  pending = HR_NONE;
+  mark_typed();
+  release_other();
+}
+
+static void resolve_hold(void)
+{
+  hr_hold(pending);
+  pending = HR_NONE;
+  release_other();
+}
+
+// Another key goes down while one is pending; true when it's held back
+static bool pending_press(uint16_t keycode, keypos_t pos)
+{
+  if (pending == HR_NONE)
+  {
+    return false;
+  }
+  if (other_code != KC_NO || HOME_ROW_IS_RIGHT(pos) == HOME_ROW_IS_RIGHT(pending_pos))
+  {
+    // A third key or one on the same hand: it's typing
+    resolve_tap();
+    return false;
+  }
+  if (hr_silent(keycode))
+  {
+    // Nothing to roll into, so it's a modifier for the layer or the mouse
+    resolve_hold();
+    return false;
+  }
+  if (!IS_KEY(keycode))
+  {
+    // Tap dances, one-shot mods and the like can't be held back and sent
+    // later with register_code: take it as a roll
+    resolve_tap();
+    return false;
+  }
+  other_code = keycode;
+  other_pos = pos;
+  return true;
+}
+
+bool process_home_row(uint16_t keycode, keyrecord_t *record)
+{
+  uint8_t i = hr_index(keycode);
+  keypos_t pos = record->event.key;
+
+  if (record->event.pressed)
+  {
+    if (pending_press(keycode, pos))
+    {
+      return false;
+    }
+#ifndef DISABLE_LEADER
+    if (leading)
+    {
+      // The leader sequence wants the plain letter
+      i = HR_NONE;
+    }
+#endif
+    if (i == HR_NONE)
+    {
+      mark_typed();
+      return true;
+    }
+    hr_press(i, pos);
+    return false;
+  }
+
+  if (other_code != KC_NO && other_pos.row == pos.row && other_pos.col == pos.col)
+  {
+    // Pressed and released inside the pending key: a chord
+    resolve_hold();
+  }
+  i = hr_find(pos);
+  if (i == HR_NONE)
+  {
+    // Not ours, or pressed while leading so the press went through untouched
+    return true;
+  }
+  hr_down &= ~(1 << i);
+  if (pending == i)
+  {
+    // Released before anything else was: a tap, or a roll into the other key
+    resolve_tap();
+  }
+  if (hr_tapped & (1 << i))
+  {
+    hr_tapped &= ~(1 << i);
+    unregister_code(hr_codes[i]);
+  }
+  if (hr_held & (1 << i))
+  {
+    hr_held &= ~(1 << i);
+    unregister_mods(hr_mods[i]);
+  }
+  return false;
+}
+
+uint16_t home_row_due_in(void)
+{
+  if (pending == HR_NONE)
+  {
+    return 0xFFFF;
+  }
+  uint16_t elapsed = timer_elapsed(pending_timer);
+  return elapsed >= TAPPING_TERM ? 0 : TAPPING_TERM - elapsed;
+}
+
+void home_row_task(void)
+{
+  if (pending != HR_NONE && timer_elapsed(pending_timer) >= TAPPING_TERM)
+  {
+    resolve_hold();
+  }
+  if (streak && timer_elapsed(streak_timer) >= HOME_ROW_STREAK_TERM)
+  {
+    streak = false;
+  }
+}
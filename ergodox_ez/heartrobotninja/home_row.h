@@ -0,0 +1,46 @@
+#ifndef HOME_ROW_H
+#define HOME_ROW_H
+
+#include "quantum.h"
+
+/* Home row mods
+ *
+ * A R S T and N E I O act as GUI ALT CTRL SHIFT when held, mirrored on the
+ * right hand. The keymap keeps the plain letters; process_home_row() owns
+ * them on the way through process_record_user.
+ *
+ * Hold or tap is decided by what the other keys do rather than by waiting
+ * out TAPPING_TERM:
+ *   - pressed within HOME_ROW_STREAK_TERM of the last typed key: tap at once
+ *   - released before any other key goes down: tap on release
+ *   - another key on the same hand goes down first: tap, it's a roll ("st")
+ *   - a key on the other hand goes down and comes up while it's held: hold,
+ *     it's a chord; that key is held back until then
+ *   - it comes up first, or a third key goes down: tap, it's a roll ("th")
+ *   - still held at TAPPING_TERM: hold, for modifier + mouse and the like
+ *   - a layer, mouse or leader key on the other hand goes down: hold at once
+ *   - a tap dance, one-shot mod or other key that can't be held back goes
+ *     down on the other hand: tap at once, it's a roll
+ *
+ * Typing only waits on the other hand's key, never on a timer. Same-hand
+ * chords stay on the thumb one-shot mods.
+ */
+
+#ifndef HOME_ROW_STREAK_TERM
+#define HOME_ROW_STREAK_TERM 150
+#endif
+
+// Keyboard specific, see config.h
+#ifndef HOME_ROW_IS_RIGHT
+#error "HOME_ROW_IS_RIGHT(keypos) must say which half a matrix position is on"
+#endif
+
+bool process_home_row(uint16_t keycode, keyrecord_t *record);
+// Milliseconds until a held back key turns into a hold, 0xFFFF when none is
+uint16_t home_row_due_in(void);
+void home_row_task(void); // call once per scan
+
+// Called as a key held back here is typed; return false to drop it
+bool home_row_tap_user(uint8_t keycode);
+
+#endif
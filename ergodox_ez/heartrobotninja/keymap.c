@@ -1,9 +1,17 @@
 #include "action_layer.h"
 #include "action_util.h"
+#include "autocorrect.h"
 #include "debug.h"
 #include "eeconfig.h"
+#include "eeprom_queue.h"
 #include "ergodox_ez.h"
-#include "version.h"
+#include "home_row.h"
+#include "journal.h"
+#include "mouse_keys.h"
+#include "scheduler.h"
+#include "snippets.h"
+#include "steno.h"
+#include "unicode_input.h"
 #include "wait.h"
 
 /* Aliases */
@@ -15,6 +23,7 @@ enum
   COLE = 0,
   LOWER, // right hand 10 key
   RAISE, // Function keys
+  STENO, // Steno chords, toggled from AUX
   AUX,   // Things like rebooting the board to be flashed. NUM + RAISE
 };
 
@@ -29,6 +38,7 @@ enum
   // Config Macros
   CF_EPRM,
   CF_VERS,
+  CF_JRNL,
 
   // RGB Macro
   RGB_ANI,
@@ -48,17 +58,19 @@ enum
   TD_FIND,
 };
 
-/* OS Identifier */
-enum
-{
-  OS_WIN = 0,
-  OS_OSX,
-  OS_LIN,
-};
-
-uint8_t os_type = OS_WIN;
+/* Unicode input method, one of UNI_* from unicode_input.h. Alt codes need
+ * nothing installed on Windows, so they're where a fresh board starts.
+ */
+uint8_t uni_method = UNI_WIN_ALTCODE;
 
+static uint8_t rgb_hold = SCHED_NONE;
+/* When every scheduler timer is taken, RGB_ANI and the leader time
+ * themselves from matrix_scan_user instead.
+ */
+static bool rgb_polled = false;
 static uint16_t rgb_timer;
+static bool leader_polled = false;
+static uint8_t leader_timer = SCHED_NONE;
 bool time_travel = false;
 bool skip_leds = false;
 
@@ -196,17 +208,60 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
             ____,
             ____, ____, ____),
 
+        /* Keymap 4: Steno Layer
+         *
+         * ,-----------------------------------------------------.           ,-----------------------------------------------------.
+         * |           |  #   |  #   |  #   |  #   |  #   |  #   |           |      |  #   |  #   |  #   |  #   |  #   |   #       |
+         * |           |      |      |      |      |      |      |           |      |      |      |      |      |      |           |
+         * |-----------+------+------+------+------+------+------|           |------+------+------+------+------+------+-----------|
+         * |    Fn     |  S   |  T   |  P   |  H   |  *   |      |           |      |  *   |  F   |  P   |  L   |  T   |   D       |
+         * |-----------+------+------+------+------+------|  *   |           |  *   |------+------+------+------+------+-----------|
+         * |   PWR     |  S   |  K   |  W   |  R   |  *   |------|           |------|  *   |  R   |  B   |  G   |  S   |   Z       |
+         * |-----------+------+------+------+------+------|  *   |           |  *   |------+------+------+------+------+-----------|
+         * |           |      |      |      |      |      |      |           |      |      |      |      |      |      |           |
+         * `-----------+------+------+------+------+-------------'           `-------------+------+------+------+------+-----------'
+         *     | ----  |      |      |Gemini| Bolt |                                       | ---- | ---- | ---- | ---- | ----  |
+         *     `-----------------------------------'                                       `-----------------------------------'
+         *                                         ,-------------.           ,-------------.
+         *                                         |      |      |           |      |      |
+         *                                  ,------|------|------|           |------+------+------.
+         *                                  |      |      |      |           |      |      |      |
+         *                                  |  A   |  O   |------|           |------|  E   |  U   |
+         *                                  |      |      |      |           |      |      |      |
+         *                                  `--------------------'           `--------------------'
+         */
+        [STENO] = KEYMAP(
+            // Left Hand
+            KC_NO, STN_N1, STN_N2, STN_N3, STN_N4, STN_N5, STN_N6,
+            STN_FN, STN_S1, STN_TL, STN_PL, STN_HL, STN_ST1, STN_ST1,
+            STN_PWR, STN_S2, STN_KL, STN_WL, STN_RL, STN_ST2,
+            KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, STN_ST2,
+            ____, KC_NO, KC_NO, STN_GEMINI, STN_BOLT,
+            KC_NO, KC_NO,
+            KC_NO,
+            STN_A, STN_O, KC_NO,
+
+            // Right Hand
+            KC_NO, STN_N7, STN_N8, STN_N9, STN_NA, STN_NB, STN_NC,
+            STN_ST3, STN_ST3, STN_FR, STN_PR, STN_LR, STN_TR, STN_DR,
+            STN_ST4, STN_RR, STN_BR, STN_GR, STN_SR, STN_ZR,
+            STN_ST4, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+            ____, ____, ____, ____, ____,
+            KC_NO, KC_NO,
+            KC_NO,
+            KC_NO, STN_E, STN_U),
+
         /* Keymap 7: Configuration Layer
          *
          * ,-----------------------------------------------------.           ,-----------------------------------------------------.
-         * |  EEPROM   | ---- | ---- | ---- | ---- | ---- | ---- |           | PWR  | ---- | ---- | ---- | ---- | ---- |           |
+         * |  EEPROM   | STENO| JRNL | ---- | ---- | ---- | ---- |           | PWR  | ---- | ---- | ---- | ---- | ---- |           |
          * |           |      |      |      |      |      |      |           |      |      |      |      |      |      |  VERSION  |
          * |-----------+------+------+------+------+------+------|           |------+------+------+------+------+------+-----------|
-         * |   ----    | ---- | ---- | ---- | ---- | ---- |      |           |      | ---- | ---- | ---- | ---- | ---- |   ----    |
+         * |   ----    | ---- | ACL2 | ACL1 | MS U | WH U |      |           |      | ---- | ---- | ---- | ---- | ---- |   ----    |
          * |-----------+------+------+------+------+------| ---- |           | SLP |------+------+------+------+------+-----------|
-         * |   ----    | ---- | ---- | ---- | ---- | ---- |------|           |------| ---- | ---- | ---- | ---- | ---- |   ----    |
+         * |   ----    | ACL0 | ---- | MS L | MS D | MS R |------|           |------| ---- | BTN1 | BTN2 | BTN3 | ---- |   ----    |
          * |-----------+------+------+------+------+------|      |           |      |------+------+------+------+------+-----------|
-         * |   ----    | ---- | ---- | ---- | ---- | ---- | ---- |           | WAKE | ---- | ---- | ---- | ---- | ---- |   ----    |
+         * |   ----    | ---- | ---- | WH L | WH D | WH R | ---- |           | WAKE | ---- | ---- | ---- | ---- | ---- |   ----    |
          * `-----------+------+------+------+------+-------------'           `-------------+------+------+------+------+-----------'
          *     | ----  | ---- | ---- | ---- | ---- |                                       | ---- | ---- | ---- | ---- | ----  |
          *     `-----------------------------------'                                       `-----------------------------------'
@@ -220,10 +275,10 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
          */
         [AUX] = KEYMAP(
             // Left Hand
-            M(CF_EPRM), ____, ____, ____, ____, ____, KC_PWR,
-            ____, ____, ____, ____, ____, ____, KC_SLEP,
-            ____, ____, ____, ____, ____, ____,
-            ____, ____, ____, ____, ____, ____, KC_WAKE,
+            M(CF_EPRM), TG(STENO), M(CF_JRNL), ____, ____, ____, KC_PWR,
+            ____, ____, KC_ACL2, KC_ACL1, KC_MS_U, KC_WH_U, KC_SLEP,
+            ____, KC_ACL0, ____, KC_MS_L, KC_MS_D, KC_MS_R,
+            ____, ____, ____, KC_WH_L, KC_WH_D, KC_WH_R, KC_WAKE,
             ____, ____, ____, ____, ____,
             ____, ____,
             ____,
@@ -232,7 +287,7 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
             // Right Hand
             KC_PWR, ____, ____, ____, ____, ____, M(CF_VERS),
             KC_SLEP, ____, ____, ____, ____, ____, ____,
-            ____, ____, ____, ____, ____, ____,
+            ____, KC_BTN1, KC_BTN2, KC_BTN3, ____, ____,
             KC_WAKE, ____, ____, ____, ____, ____, ____,
             ____, ____, ____, ____, ____,
             RGB_TOG, M(RGB_ANI),
@@ -308,6 +363,16 @@ qk_tap_dance_action_t tap_dance_actions[] = {
         [TD_UNDO] = ACTION_TAP_DANCE_FN(unredo),
         [TD_FIND] = ACTION_TAP_DANCE_FN(findreplace)};
 
+// RGB_ANI held down: back to a solid colour, otherwise it steps on release
+#define RGB_HOLD_MS 300
+
+static uint16_t rgb_held(void *data)
+{
+  rgb_hold = SCHED_NONE;
+  rgblight_mode(1);
+  return 0;
+}
+
 const macro_t *action_get_macro(keyrecord_t *record, uint8_t id, uint8_t opt)
 {
   switch (id)
@@ -324,30 +389,40 @@ const macro_t *action_get_macro(keyrecord_t *record, uint8_t id, uint8_t opt)
   case RGB_ANI:
     if (record->event.pressed)
     {
+      rgb_hold = sched_defer(RGB_HOLD_MS, rgb_held, NULL);
+      rgb_polled = rgb_hold == SCHED_NONE;
       rgb_timer = timer_read();
     }
-    else
+    else if (rgb_hold != SCHED_NONE)
     {
-      if (timer_elapsed(rgb_timer) > 300)
-      {
-        rgblight_mode(1);
-      }
-      else
-      {
-        rgblight_step();
-      }
+      sched_cancel(rgb_hold);
+      rgb_hold = SCHED_NONE;
+      rgblight_step();
     }
+    else if (rgb_polled)
+    {
+      rgb_polled = false;
+      rgblight_step();
+    }
+    break;
   case CF_EPRM:
     if (record->event.pressed)
     {
-      eeconfig_init();
+      eeq_config_init();
     }
     return false;
     break;
   case CF_VERS:
     if (record->event.pressed)
     {
-      SEND_STRING(QMK_KEYBOARD "/" QMK_KEYMAP " @ " QMK_VERSION);
+      snippet_send(SNIPPET_VERS);
+    }
+    return false;
+    break;
+  case CF_JRNL:
+    if (record->event.pressed)
+    {
+      journal_dump();
     }
     return false;
     break;
@@ -355,21 +430,82 @@ const macro_t *action_get_macro(keyrecord_t *record, uint8_t id, uint8_t opt)
   return MACRO_NONE;
 };
 
-/*
-bool process_record_user(uint16_t keycode, keyrecord_t *record)
-{}
-*/
+/* Leader sequences finish LEADER_TIMEOUT after LEAD is pressed */
+LEADER_EXTERNS();
 
-void tap(uint16_t code)
+static uint16_t leader_finish(void *data)
 {
-  register_code(code);
-  unregister_code(code);
+  leader_timer = SCHED_NONE;
+  leading = false;
+  leader_end();
+
+  SEQ_THREE_KEYS(KC_W, KC_I, KC_N) { uni_method = UNI_WIN_ALTCODE; };
+  SEQ_THREE_KEYS(KC_W, KC_H, KC_X) { uni_method = UNI_WIN_HEX; };
+  SEQ_THREE_KEYS(KC_W, KC_C, KC_P) { uni_method = UNI_WINCOMPOSE; };
+  SEQ_THREE_KEYS(KC_O, KC_S, KC_X) { uni_method = UNI_OSX; };
+  SEQ_THREE_KEYS(KC_L, KC_I, KC_N) { uni_method = UNI_LINUX; };
+
+  SEQ_ONE_KEY(KC_A) { uni_send(uni_method, 0x00E4); }; // ä
+  SEQ_TWO_KEYS(KC_A, KC_A) { uni_send(uni_method, 0x00C4); }; // Ä
+  SEQ_ONE_KEY(KC_O) { uni_send(uni_method, 0x00F6); }; // ö
+  SEQ_TWO_KEYS(KC_O, KC_O) { uni_send(uni_method, 0x00D6); }; // Ö
+  SEQ_ONE_KEY(KC_U) { uni_send(uni_method, 0x00FC); }; // ü
+  SEQ_TWO_KEYS(KC_U, KC_U) { uni_send(uni_method, 0x00DC); }; // Ü
+  SEQ_ONE_KEY(KC_S) { uni_send(uni_method, 0x00DF); }; // ß
+
+  snippet_leader(leader_sequence);
+  return 0;
 }
 
-LEADER_EXTERNS();
-void matrix_scan_user(void)
+void leader_start(void)
 {
+  leader_timer = sched_defer(LEADER_TIMEOUT + 1, leader_finish, NULL);
+  leader_polled = leader_timer == SCHED_NONE;
+}
+
+bool home_row_tap_user(uint8_t keycode)
+{
+  return autocorrect_key(keycode);
+}
 
+bool process_record_user(uint16_t keycode, keyrecord_t *record)
+{
+  journal_key(keycode, record);
+  if (keycode == KC_LEAD && record->event.pressed && leading &&
+      timer_elapsed(leader_time) >= LEADER_TIMEOUT)
+  {
+    // The sequence timed out but its scan hasn't come round: finish it now,
+    // so this LEAD starts the next one instead of being swallowed
+    sched_cancel(leader_timer);
+    leader_polled = false;
+    leader_finish(NULL);
+  }
+  if (!process_home_row(keycode, record))
+  {
+    return false;
+  }
+  if (!process_mouse_keys(keycode, record))
+  {
+    return false;
+  }
+  if (!process_steno_keys(keycode, record))
+  {
+    return false;
+  }
+  if (record->event.pressed && !autocorrect_key(keycode))
+  {
+    return false;
+  }
+  return true;
+}
+
+/* Indicators: a modifier held or one-shot lights its LED bright, the layer
+ * dims the rest. Refreshed from the scheduler rather than every scan.
+ */
+#define INDICATOR_MS 16
+
+static uint16_t indicators(void *data)
+{
   uint8_t layer = biton32(layer_state);
 
   if (keyboard_report->mods & MOD_BIT(KC_LSFT) ||
@@ -422,239 +558,34 @@ void matrix_scan_user(void)
   {
     ergodox_right_led_3_off();
   }
+  return INDICATOR_MS;
+}
 
-  LEADER_DICTIONARY()
+void matrix_scan_user(void)
+{
+  if (rgb_polled && timer_elapsed(rgb_timer) >= RGB_HOLD_MS)
   {
-    leading = false;
-    leader_end();
-
-    SEQ_THREE_KEYS(KC_W, KC_I, KC_N) { os_type = OS_WIN; };
-    SEQ_THREE_KEYS(KC_O, KC_S, KC_X) { os_type = OS_OSX; };
-    SEQ_THREE_KEYS(KC_L, KC_I, KC_N) { os_type = OS_LIN; };
-
-    SEQ_ONE_KEY(KC_A)
-    {
-      switch (os_type)
-      {
-      case OS_WIN:
-        tap(KC_NLCK);
-        register_code(KC_RALT);
-        tap(KC_KP_0);
-        tap(KC_KP_2);
-        tap(KC_KP_2);
-        tap(KC_KP_8);
-        unregister_code(KC_RALT);
-        tap(KC_NLCK);
-        break;
-      case OS_OSX:
-        register_code(KC_RALT);
-        register_code(KC_RSFT);
-        register_code(KC_SCLN);
-        unregister_code(KC_SCLN);
-        unregister_code(KC_RSFT);
-        unregister_code(KC_RALT);
-        tap(KC_A);
-        break;
-      case OS_LIN:
-        tap(KC_RALT);
-        tap(KC_DQT);
-        tap(KC_A);
-        break;
-      }
-    }
-    SEQ_TWO_KEYS(KC_A, KC_A)
-    {
-      switch (os_type)
-      {
-      case OS_WIN:
-        tap(KC_NLCK);
-        register_code(KC_RALT);
-        tap(KC_KP_0);
-        tap(KC_KP_1);
-        tap(KC_KP_9);
-        tap(KC_KP_6);
-        unregister_code(KC_RALT);
-        tap(KC_NLCK);
-        break;
-      case OS_OSX:
-        register_code(KC_RALT);
-        register_code(KC_RSFT);
-        register_code(KC_SCLN);
-        unregister_code(KC_SCLN);
-        unregister_code(KC_RSFT);
-        unregister_code(KC_RALT);
-        register_code(KC_LSFT);
-        register_code(KC_A);
-        unregister_code(KC_A);
-        unregister_code(KC_LSFT);
-        break;
-      case OS_LIN:
-        tap(KC_RALT);
-        tap(KC_DQT);
-        register_code(KC_LSFT);
-        register_code(KC_A);
-        unregister_code(KC_A);
-        unregister_code(KC_LSFT);
-        break;
-      }
-    }
-    SEQ_ONE_KEY(KC_O)
-    {
-      switch (os_type)
-      {
-      case OS_WIN:
-        tap(KC_NLCK);
-        register_code(KC_RALT);
-        tap(KC_KP_0);
-        tap(KC_KP_2);
-        tap(KC_KP_4);
-        tap(KC_KP_6);
-        unregister_code(KC_RALT);
-        tap(KC_NLCK);
-        break;
-      case OS_OSX:
-        register_code(KC_RALT);
-        register_code(KC_RSFT);
-        register_code(KC_SCLN);
-        unregister_code(KC_SCLN);
-        unregister_code(KC_RSFT);
-        unregister_code(KC_RALT);
-        tap(KC_O);
-        break;
-      case OS_LIN:
-        tap(KC_RALT);
-        tap(KC_DQT);
-        tap(KC_O);
-        break;
-      }
-    }
-    SEQ_TWO_KEYS(KC_O, KC_O)
-    {
-      switch (os_type)
-      {
-      case OS_WIN:
-        tap(KC_NLCK);
-        register_code(KC_RALT);
-        tap(KC_KP_0);
-        tap(KC_KP_2);
-        tap(KC_KP_1);
-        tap(KC_KP_4);
-        unregister_code(KC_RALT);
-        tap(KC_NLCK);
-        break;
-      case OS_OSX:
-        register_code(KC_RALT);
-        register_code(KC_RSFT);
-        register_code(KC_SCLN);
-        unregister_code(KC_SCLN);
-        unregister_code(KC_RSFT);
-        unregister_code(KC_RALT);
-        tap(LSFT(KC_O));
-        break;
-      case OS_LIN:
-        tap(KC_RALT);
-        tap(KC_DQT);
-        register_code(KC_LSFT);
-        register_code(KC_O);
-        unregister_code(KC_O);
-        unregister_code(KC_LSFT);
-        break;
-      }
-    }
-    SEQ_ONE_KEY(KC_U)
-    {
-      switch (os_type)
-      {
-      case OS_WIN:
-        tap(KC_NLCK);
-        register_code(KC_RALT);
-        tap(KC_KP_0);
-        tap(KC_KP_2);
-        tap(KC_KP_5);
-        tap(KC_KP_2);
-        unregister_code(KC_RALT);
-        tap(KC_NLCK);
-        break;
-      case OS_OSX:
-        register_code(KC_RALT);
-        register_code(KC_RSFT);
-        register_code(KC_SCLN);
-        unregister_code(KC_SCLN);
-        unregister_code(KC_RSFT);
-        unregister_code(KC_RALT);
-        tap(KC_U);
-        break;
-      case OS_LIN:
-        tap(KC_RALT);
-        tap(KC_DQT);
-        tap(KC_U);
-        break;
-      }
-    }
-    SEQ_TWO_KEYS(KC_U, KC_U)
-    {
-      switch (os_type)
-      {
-      case OS_WIN:
-        tap(KC_NLCK);
-        register_code(KC_RALT);
-        tap(KC_KP_0);
-        tap(KC_KP_2);
-        tap(KC_KP_2);
-        tap(KC_KP_0);
-        unregister_code(KC_RALT);
-        tap(KC_NLCK);
-        break;
-      case OS_OSX:
-        register_code(KC_RALT);
-        register_code(KC_RSFT);
-        register_code(KC_SCLN);
-        unregister_code(KC_SCLN);
-        unregister_code(KC_RSFT);
-        unregister_code(KC_RALT);
-        tap(LSFT(KC_U));
-        break;
-      case OS_LIN:
-        tap(KC_RALT);
-        tap(KC_DQT);
-        register_code(KC_LSFT);
-        register_code(KC_U);
-        unregister_code(KC_U);
-        unregister_code(KC_LSFT);
-        break;
-      }
-    }
-    SEQ_ONE_KEY(KC_S)
-    {
-      switch (os_type)
-      {
-      case OS_WIN:
-        tap(KC_NLCK);
-        register_code(KC_RALT);
-        tap(KC_KP_0);
-        tap(KC_KP_2);
-        tap(KC_KP_2);
-        tap(KC_KP_3);
-        unregister_code(KC_RALT);
-        tap(KC_NLCK);
-        break;
-      case OS_OSX:
-        register_code(KC_RALT);
-        tap(KC_S);
-        unregister_code(KC_RALT);
-        break;
-      case OS_LIN:
-        tap(KC_RALT);
-        tap(KC_S);
-        tap(KC_S);
-        break;
-      }
-    }
+    rgb_polled = false;
+    rgb_held(NULL);
+  }
+  // QMK sets leader_time after leader_start returns, before the next scan
+  if (leader_polled && timer_elapsed(leader_time) > LEADER_TIMEOUT)
+  {
+    leader_polled = false;
+    leader_finish(NULL);
   }
+  sched_task();
+  eeq_task();
+  home_row_task();
+  snippet_task();
+  mouse_keys_task();
+  steno_task();
+  journal_task();
 }
 
 void matrix_init_user(void)
 {
+  journal_init();
 
   ergodox_led_all_on();
   rgblight_init();
@@ -677,4 +608,5 @@ void matrix_init_user(void)
   wait_ms(1000);
 
   rgblight_effect_knight(50);
+  sched_defer(0, indicators, NULL);
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "mouse_keys.h"
+#include "host.h"
+#include "mouse_curve.h"
+
+#define MK_UP 1
+#define MK_DOWN 2
+#define MK_LEFT 4
+#define MK_RIGHT 8
+
+#define MK_PX_SHIFT 4 // curve entries are 1/16 px
+#define MK_WHEEL_SHIFT (MK_PX_SHIFT + MOUSE_KEYS_WHEEL_SHIFT)
+
+typedef struct
+{
+  uint8_t dirs;  // MK_* held
+  uint8_t step;  // reports since it started, index into mouse_curve
+  uint16_t frac; // movement owed, in curve units
+} mk_motion_t;
+
+static mk_motion_t pointer;
+static mk_motion_t wheel;
+static uint8_t buttons;
+static uint8_t accel; // bit per KC_ACL key held
+
+/* Mouse keys down, by the matrix position that pressed them. A release is
+ * looked up on the layers up by then, so it's matched by position instead.
+ */
+static uint8_t held_key[MOUSE_KEYS_HELD]; // KC_NO for a free slot
+static keypos_t held_pos[MOUSE_KEYS_HELD];
+static uint16_t mk_timer;
+
+// Whole units of movement for this report, 0 when the directions cancel
+static int8_t motion_step(mk_motion_t *m, uint8_t shift, int8_t *h, int8_t *v)
+{
+  *h = (m->dirs & MK_RIGHT ? 1 : 0) - (m->dirs & MK_LEFT ? 1 : 0);
+  *v = (m->dirs & MK_DOWN ? 1 : 0) - (m->dirs & MK_UP ? 1 : 0);
+  if (!*h && !*v)
+  {
+    return 0;
+  }
+
+  uint8_t speed = pgm_read_byte(&mouse_curve[m->step]);
+  if (m->step < MOUSE_CURVE_STEPS - 1)
+  {
+    m->step++;
+  }
+  if (accel & 1)
+  {
+    speed >>= 2;
+  }
+  else if (accel & 2)
+  {
+    speed >>= 1;
+  }
+  else if (accel & 4)
+  {
+    speed = pgm_read_byte(&mouse_curve[MOUSE_CURVE_STEPS - 1]);
+  }
+  if (*h && *v)
+  {
+    speed = ((uint16_t)speed * 181 + 128) >> 8;
+  }
+
+  m->frac += speed;
+  uint16_t units = m->frac >> shift;
+  m->frac -= units << shift;
+  return units > 127 ? 127 : units;
+}
+
+static void send_report(void)
+{
+  report_mouse_t report = {.buttons = buttons};
+  int8_t h, v;
+  int8_t px = motion_step(&pointer, MK_PX_SHIFT, &h, &v);
+  report.x = h * px;
+  report.y = v * px;
+  int8_t detents = motion_step(&wheel, MK_WHEEL_SHIFT, &h, &v);
+  report.h = h * detents;
+  report.v = -v * detents; // wheel up is positive
+  if (report.x || report.y || report.h || report.v)
+  {
+    host_mouse_send(&report);
+  }
+}
+
+static void mouse_key(uint8_t keycode, bool pressed)
+{
+  mk_motion_t *m;
+  uint8_t dir;
+
+  switch (keycode)
+  {
+  case KC_MS_BTN1 ... KC_MS_BTN5:
+  {
+    uint8_t bit = 1 << (keycode - KC_MS_BTN1);
+    buttons = pressed ? buttons | bit : buttons & ~bit;
+    report_mouse_t report = {.buttons = buttons};
+    host_mouse_send(&report);
+    return;
+  }
+  case KC_MS_ACCEL0 ... KC_MS_ACCEL2:
+  {
+    uint8_t bit = 1 << (keycode - KC_MS_ACCEL0);
+    accel = pressed ? accel | bit : accel & ~bit;
+    return;
+  }
+  case KC_MS_UP ... KC_MS_RIGHT:
+    m = &pointer;
+    dir = 1 << (keycode - KC_MS_UP);
+    break;
+  default: // KC_MS_WH_UP ... KC_MS_WH_RIGHT
+    m = &wheel;
+    dir = 1 << (keycode - KC_MS_WH_UP);
+    break;
+  }
+
+  if (!pressed)
+  {
+    m->dirs &= ~dir;
+    return;
+  }
+  bool moving = pointer.dirs || wheel.dirs;
+  if (!m->dirs)
+  {
+    // Start just short of a whole pixel or detent, so a tap always moves
+    m->step = 0;
+    m->frac = m == &wheel ? (1 << MK_WHEEL_SHIFT) - 1 : (1 << MK_PX_SHIFT) - 1;
+  }
+  m->dirs |= dir;
+  if (!moving)
+  {
+    mk_timer = timer_read();
+    send_report();
+  }
+}
+
+bool process_mouse_keys(uint16_t keycode, keyrecord_t *record)
+{
+  keypos_t pos = record->event.key;
+  uint8_t slot = MOUSE_KEYS_HELD;
+
+  // The key held at this position, or a free slot for a press
+  for (uint8_t i = 0; i < MOUSE_KEYS_HELD; i++)
+  {
+    if (held_key[i] == KC_NO ? record->event.pressed
+                             : held_pos[i].row == pos.row && held_pos[i].col == pos.col)
+    {
+      slot = i;
+      break;
+    }
+  }
+
+  if (!record->event.pressed)
+  {
+    if (slot == MOUSE_KEYS_HELD)
+    {
+      return true;
+    }
+    mouse_key(held_key[slot], false);
+    held_key[slot] = KC_NO;
+    return false;
+  }
+  if (!IS_MOUSEKEY(keycode))
+  {
+    return true;
+  }
+  if (slot < MOUSE_KEYS_HELD)
+  {
+    held_key[slot] = keycode;
+    held_pos[slot] = pos;
+    mouse_key(keycode, true);
+  }
+  return false;
+}
+
+uint16_t mouse_keys_due_in(void)
+{
+  if (!pointer.dirs && !wheel.dirs)
+  {
+    return 0xFFFF;
+  }
+  uint16_t elapsed = timer_elapsed(mk_timer);
+  return elapsed >= MOUSE_CURVE_INTERVAL ? 0 : MOUSE_CURVE_INTERVAL - elapsed;
+}
+
+void mouse_keys_task(void)
+{
+  if (!pointer.dirs && !wheel.dirs)
+  {
+    return;
+  }
+  uint16_t elapsed = timer_elapsed(mk_timer);
+  if (elapsed < MOUSE_CURVE_INTERVAL)
+  {
+    return;
+  }
+  // Keep to the interval, unless the scan loop fell a whole report behind
+  mk_timer = elapsed < 2 * MOUSE_CURVE_INTERVAL ? mk_timer + MOUSE_CURVE_INTERVAL : timer_read();
+  send_report();
+}
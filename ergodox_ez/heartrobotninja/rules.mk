@@ -1,7 +1,7 @@
 BOOTMAGIC_ENABLE=no
 COMMAND_ENABLE=no
 SLEEP_LED_ENABLE=no
-NKRO_ENABLE = yes
+NKRO_ENABLE = no
 FORCE_NKRO = no
 DEBUG_ENABLE = no
 CONSOLE_ENABLE = no
@@ -9,10 +9,12 @@ TAP_DANCE_ENABLE = yes
 KEYLOGGER_ENABLE = no
 UCIS_ENABLE = no
 MOUSEKEY_ENABLE = no
+MOUSE_ENABLE = yes
 AUTOLOG_ENABLE = no
 RGBLIGHT_ENABLE = yes
 RGBLIGHT_ANIMATION = yes
 EXTRAKEY_ENABLE = yes
+VIRTSER_ENABLE = yes
 
 OPT_DEFS += -DUSER_PRINT
 
@@ -29,6 +31,16 @@ KEYMAP_BRANCH = $(shell \
 
 OPT_DEFS += -DKEYMAP_VERSION=\"$(KEYMAP_VERSION)\\\#$(KEYMAP_BRANCH)\"
 
+SRC += eeprom_queue.c
+SRC += home_row.c
+SRC += autocorrect.c
+SRC += unicode_input.c
+SRC += snippets.c
+SRC += scheduler.c
+SRC += mouse_keys.c
+SRC += steno.c
+SRC += journal.c
+
 ifndef QUANTUM_DIR
 	include ../../../../Makefile
 endif
\ No newline at end of file
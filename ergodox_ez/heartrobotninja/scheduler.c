@@ -0,0 +1,184 @@
+#include "scheduler.h"
+
+// Where a timer is, besides a wheel slot
+#define SCHED_FREE 0xFE
+#define SCHED_DUE 0xFD
+
+typedef struct
+{
+  sched_fn_t fn; // NULL once cancelled
+  void *data;
+  uint8_t slot;
+  uint8_t turns; // times round the wheel before it's due
+  uint8_t next;  // next timer in the same slot
+} sched_timer_t;
+
+static sched_timer_t timers[SCHED_TIMERS];
+static uint8_t wheel[SCHED_SLOTS];
+static uint8_t cursor;      // slot of the last tick
+static uint16_t wheel_time; // time of the last tick
+static uint8_t live;
+static bool started;
+
+static void sched_init(void)
+{
+  for (uint8_t i = 0; i < SCHED_TIMERS; i++)
+  {
+    timers[i].slot = SCHED_FREE;
+  }
+  for (uint8_t i = 0; i < SCHED_SLOTS; i++)
+  {
+    wheel[i] = SCHED_NONE;
+  }
+  wheel_time = timer_read();
+  started = true;
+}
+
+static void sched_link(uint8_t i, uint16_t delay_ms)
+{
+  // Ticks are counted from the last one, so round up what's left of it too
+  uint16_t ticks =
+          ((uint32_t)delay_ms + timer_elapsed(wheel_time) + SCHED_TICK_MS - 1) / SCHED_TICK_MS;
+  if (ticks == 0)
+  {
+    ticks = 1;
+  }
+  uint8_t slot = (cursor + ticks) % SCHED_SLOTS;
+  timers[i].slot = slot;
+  timers[i].turns = (ticks - 1) / SCHED_SLOTS;
+  timers[i].next = wheel[slot];
+  wheel[slot] = i;
+}
+
+static void sched_unlink(uint8_t i)
+{
+  uint8_t *p = &wheel[timers[i].slot];
+  while (*p != i)
+  {
+    p = &timers[*p].next;
+  }
+  *p = timers[i].next;
+}
+
+uint8_t sched_defer(uint16_t delay_ms, sched_fn_t fn, void *data)
+{
+  if (!started)
+  {
+    sched_init();
+  }
+  for (uint8_t i = 0; i < SCHED_TIMERS; i++)
+  {
+    if (timers[i].slot == SCHED_FREE)
+    {
+      timers[i].fn = fn;
+      timers[i].data = data;
+      sched_link(i, delay_ms);
+      live++;
+      return i;
+    }
+  }
+  return SCHED_NONE;
+}
+
+void sched_cancel(uint8_t handle)
+{
+  if (handle >= SCHED_TIMERS || timers[handle].slot == SCHED_FREE)
+  {
+    return;
+  }
+  if (timers[handle].slot != SCHED_DUE)
+  {
+    sched_unlink(handle);
+    timers[handle].slot = SCHED_FREE;
+    live--;
+  }
+  // A due timer is freed by sched_task when it gets to it
+  timers[handle].fn = NULL;
+}
+
+static void run_slot(void)
+{
+  // Take the due timers off the slot first, callbacks may add to it
+  uint8_t due = SCHED_NONE;
+  uint8_t *p = &wheel[cursor];
+  while (*p != SCHED_NONE)
+  {
+    sched_timer_t *t = &timers[*p];
+    if (t->turns)
+    {
+      t->turns--;
+      p = &t->next;
+      continue;
+    }
+    uint8_t i = *p;
+    *p = t->next;
+    t->slot = SCHED_DUE;
+    t->next = due;
+    due = i;
+  }
+
+  while (due != SCHED_NONE)
+  {
+    uint8_t i = due;
+    sched_timer_t *t = &timers[i];
+    due = t->next;
+
+    uint16_t again = t->fn ? t->fn(t->data) : 0;
+    if (again && t->fn)
+    {
+      sched_link(i, again);
+    }
+    else
+    {
+      t->slot = SCHED_FREE;
+      live--;
+    }
+  }
+}
+
+uint16_t sched_due_in(void)
+{
+  uint32_t soonest = 0xFFFF;
+  if (!started || !live)
+  {
+    return soonest;
+  }
+  uint16_t elapsed = timer_elapsed(wheel_time);
+  for (uint8_t i = 0; i < SCHED_TIMERS; i++)
+  {
+    if (timers[i].slot >= SCHED_SLOTS)
+    {
+      continue;
+    }
+    // Its slot comes round this many ticks after the last one
+    uint32_t ticks = (timers[i].slot + SCHED_SLOTS - cursor - 1) % SCHED_SLOTS + 1 +
+                     (uint32_t)timers[i].turns * SCHED_SLOTS;
+    uint32_t at = ticks * SCHED_TICK_MS;
+    uint32_t in = at > elapsed ? at - elapsed : 0;
+    if (in < soonest)
+    {
+      soonest = in;
+    }
+  }
+  return soonest;
+}
+
+void sched_task(void)
+{
+  if (!started)
+  {
+    sched_init();
+  }
+  if (!live)
+  {
+    // Nothing to run, keep the wheel at the current time
+    wheel_time = timer_read();
+    return;
+  }
+  while (timer_elapsed(wheel_time) >= SCHED_TICK_MS)
+  {
+    wheel_time += SCHED_TICK_MS;
+    cursor = (cursor + 1) % SCHED_SLOTS;
+    run_slot();
+  }
+}
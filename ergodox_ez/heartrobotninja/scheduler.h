@@ -0,0 +1,45 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "quantum.h"
+
+/* Deferred and periodic callbacks
+ *
+ * Timers hang off a wheel of SCHED_SLOTS slots, one per SCHED_TICK_MS.
+ * sched_task() compares the clock with the next tick and returns; only once
+ * a tick passes is that tick's slot walked, so a scan pays for the timers
+ * that are due and nothing else. A timer more than one turn of the wheel
+ * away counts down the turns it has left each time its slot comes round.
+ *
+ * A callback returns how many ms until it should run again, or 0 when it's
+ * done. It runs at or up to one tick after the time asked for.
+ */
+
+#ifndef SCHED_TICK_MS
+#define SCHED_TICK_MS 8
+#endif
+
+#ifndef SCHED_TIMERS
+#define SCHED_TIMERS 8
+#endif
+
+#define SCHED_SLOTS 32
+#define SCHED_NONE 0xFF
+
+typedef uint16_t (*sched_fn_t)(void *data);
+
+// Returns a handle for sched_cancel, or SCHED_NONE when every timer is taken
+uint8_t sched_defer(uint16_t delay_ms, sched_fn_t fn, void *data);
+
+/* Stops a timer, including a periodic one from inside its own callback.
+ * Handles are reused once a timer is done, so a caller that keeps one must
+ * forget it when the callback returns 0.
+ */
+void sched_cancel(uint8_t handle);
+
+// ms until the next timer is due, 0xFFFF when none is
+uint16_t sched_due_in(void);
+
+void sched_task(void); // call once per scan
+
+#endif
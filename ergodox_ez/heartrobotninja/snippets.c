@@ -0,0 +1,197 @@
+#define SNIPPET_TABLES
+#include "snippets.h"
+#include "version.h"
+
+/* Keys for ' ' to '~' on a US layout, bit 7 set when shifted */
+#define SH(kc) ((kc) | 0x80)
+
+static const uint8_t PROGMEM ascii_keys[] = {
+        KC_SPC, SH(KC_1), SH(KC_QUOT), SH(KC_3), SH(KC_4), SH(KC_5), SH(KC_7), KC_QUOT,
+        SH(KC_9), SH(KC_0), SH(KC_8), SH(KC_EQL), KC_COMM, KC_MINS, KC_DOT, KC_SLSH,
+        KC_0, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7,
+        KC_8, KC_9, SH(KC_SCLN), KC_SCLN, SH(KC_COMM), KC_EQL, SH(KC_DOT), SH(KC_SLSH),
+        SH(KC_2), SH(KC_A), SH(KC_B), SH(KC_C), SH(KC_D), SH(KC_E), SH(KC_F), SH(KC_G),
+        SH(KC_H), SH(KC_I), SH(KC_J), SH(KC_K), SH(KC_L), SH(KC_M), SH(KC_N), SH(KC_O),
+        SH(KC_P), SH(KC_Q), SH(KC_R), SH(KC_S), SH(KC_T), SH(KC_U), SH(KC_V), SH(KC_W),
+        SH(KC_X), SH(KC_Y), SH(KC_Z), KC_LBRC, KC_BSLS, KC_RBRC, SH(KC_6), SH(KC_MINS),
+        KC_GRV, KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G,
+        KC_H, KC_I, KC_J, KC_K, KC_L, KC_M, KC_N, KC_O,
+        KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W,
+        KC_X, KC_Y, KC_Z, SH(KC_LBRC), SH(KC_BSLS), SH(KC_RBRC), SH(KC_GRV)};
+
+static const char PROGMEM build_keyboard[] = QMK_KEYBOARD;
+static const char PROGMEM build_keymap[] = QMK_KEYMAP;
+static const char PROGMEM build_version[] = QMK_VERSION;
+
+/* Decoder state for the snippet going out */
+static bool running;
+static uint16_t text_pos;            // next symbol in snippet_text
+static uint8_t stack[SNIPPET_DEPTH]; // right halves of pairs still to expand
+static uint8_t depth;
+static const char *build_string;     // placeholder being typed, NULL otherwise
+
+/* Stroke on the wire and the one waiting for it to be released */
+static uint8_t held; // key, bit 7 shift
+static uint8_t next;
+
+void snippet_send(uint8_t n)
+{
+  if (running || n >= SNIPPET_COUNT)
+  {
+    return;
+  }
+  text_pos = pgm_read_word(&snippet_index[n]);
+  depth = 0;
+  build_string = NULL;
+  next = KC_NO;
+  running = true;
+}
+
+bool snippet_leader(const uint16_t *sequence)
+{
+  for (uint8_t n = 0; n < SNIPPET_COUNT; n++)
+  {
+    uint8_t i = 0;
+    while (i < 5 && pgm_read_byte(&snippet_triggers[n][i]) == sequence[i])
+    {
+      i++;
+    }
+    if (i == 5)
+    {
+      snippet_send(n);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Next character of the snippet, 0 at its end
+static char next_char(void)
+{
+  for (;;)
+  {
+    uint8_t sym;
+    if (build_string)
+    {
+      sym = pgm_read_byte(build_string);
+      if (sym)
+      {
+        build_string++;
+        return sym;
+      }
+      build_string = NULL;
+    }
+
+    if (depth)
+    {
+      sym = stack[--depth];
+    }
+    else
+    {
+      sym = pgm_read_byte(&snippet_text[text_pos]);
+      if (!sym)
+      {
+        return 0;
+      }
+      text_pos++;
+    }
+    while (sym & 0x80)
+    {
+      stack[depth++] = pgm_read_byte(&snippet_pairs[sym & 0x7F][1]);
+      sym = pgm_read_byte(&snippet_pairs[sym & 0x7F][0]);
+    }
+
+    switch (sym)
+    {
+    case SNIPPET_KEYBOARD:
+      build_string = build_keyboard;
+      break;
+    case SNIPPET_KEYMAP:
+      build_string = build_keymap;
+      break;
+    case SNIPPET_VERSION:
+      build_string = build_version;
+      break;
+    default:
+      return sym;
+    }
+  }
+}
+
+static uint8_t char_key(char c)
+{
+  if (c == '\n')
+  {
+    return KC_ENT;
+  }
+  if (c == '\t')
+  {
+    return KC_TAB;
+  }
+  if (c < ' ' || c > '~')
+  {
+    return KC_NO;
+  }
+  return pgm_read_byte(&ascii_keys[c - ' ']);
+}
+
+static void set_held(uint8_t key)
+{
+  if (held & 0x80)
+  {
+    del_weak_mods(MOD_BIT(KC_LSFT));
+  }
+  if (held != KC_NO)
+  {
+    del_key(held & 0x7F);
+  }
+  if (key & 0x80)
+  {
+    add_weak_mods(MOD_BIT(KC_LSFT));
+  }
+  if (key != KC_NO)
+  {
+    add_key(key & 0x7F);
+  }
+  held = key;
+  send_keyboard_report();
+}
+
+bool snippet_pending(void)
+{
+  return running;
+}
+
+/* One report per scan. Keys are rolled, each report releasing the last key
+ * and pressing the next, except that a key repeated needs a report of its
+ * own to let go first.
+ */
+void snippet_task(void)
+{
+  if (!running)
+  {
+    return;
+  }
+  if (next == KC_NO)
+  {
+    char c;
+    do
+    {
+      c = next_char();
+    } while (c && char_key(c) == KC_NO);
+    if (!c)
+    {
+      set_held(KC_NO);
+      running = false;
+      return;
+    }
+    next = char_key(c);
+  }
+  if (held != KC_NO && (held & 0x7F) == (next & 0x7F))
+  {
+    set_held(KC_NO);
+    return;
+  }
+  set_held(next);
+  next = KC_NO;
+}
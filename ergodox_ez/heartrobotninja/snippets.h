@@ -0,0 +1,28 @@
+#ifndef SNIPPETS_H
+#define SNIPPETS_H
+
+#include "quantum.h"
+#include "snippets_data.h"
+
+/* Text snippets
+ *
+ * LEAD followed by a snippet's keys (see snippets.txt) types its text. The
+ * texts live in one PROGMEM blob compressed by byte pair encoding: bytes
+ * 0x80-0xFF stand for a pair of symbols from snippet_pairs, which may be
+ * pairs themselves. snippet_task() expands one character per scan using a
+ * stack of SNIPPET_DEPTH bytes, so no snippet is ever whole in RAM and a
+ * long one doesn't stall the scan loop while it goes out.
+ *
+ * snippets_data.h is generated by make -C sim snippets and names each
+ * snippet SNIPPET_<KEYS>.
+ */
+
+void snippet_send(uint8_t n);
+
+// Sends the snippet matching a finished leader sequence, if there is one
+bool snippet_leader(const uint16_t *sequence);
+
+bool snippet_pending(void); // a snippet is still being typed
+void snippet_task(void);    // call once per scan
+
+#endif
@@ -0,0 +1,172 @@
+// Generated by sim/build/snippets_gen from snippets.txt, do not edit
+// 21 snippets, 1607 bytes of text in 1156 bytes with 126 pairs and the index
+
+#ifndef SNIPPETS_DATA_H
+#define SNIPPETS_DATA_H
+
+enum
+{
+  SNIPPET_VERS,
+  SNIPPET_QMK,
+  SNIPPET_GH,
+  SNIPPET_SIG,
+  SNIPPET_BR,
+  SNIPPET_LGTM,
+  SNIPPET_NIT,
+  SNIPPET_TODO,
+  SNIPPET_FIXME,
+  SNIPPET_BUG,
+  SNIPPET_PR,
+  SNIPPET_INC,
+  SNIPPET_GUARD,
+  SNIPPET_MAIN,
+  SNIPPET_FOR,
+  SNIPPET_SW,
+  SNIPPET_PY,
+  SNIPPET_SH,
+  SNIPPET_GPL,
+  SNIPPET_MIT,
+  SNIPPET_SHRUG,
+  SNIPPET_COUNT,
+};
+
+#ifdef SNIPPET_TABLES
+
+// Placeholders for the build strings
+#define SNIPPET_KEYBOARD 1
+#define SNIPPET_KEYMAP 2
+#define SNIPPET_VERSION 3
+
+#define SNIPPET_DEPTH 9
+
+static const uint8_t PROGMEM snippet_triggers[SNIPPET_COUNT][5] = {
+        {25, 8, 21, 22, 0}, // vers
+        {20, 16, 14, 0, 0}, // qmk
+        {10, 11, 0, 0, 0}, // gh
+        {22, 12, 10, 0, 0}, // sig
+        {5, 21, 0, 0, 0}, // br
+        {15, 10, 23, 16, 0}, // lgtm
+        {17, 12, 23, 0, 0}, // nit
+        {23, 18, 7, 18, 0}, // todo
+        {9, 12, 27, 16, 8}, // fixme
+        {5, 24, 10, 0, 0}, // bug
+        {19, 21, 0, 0, 0}, // pr
+        {12, 17, 6, 0, 0}, // inc
+        {10, 24, 4, 21, 7}, // guard
+        {16, 4, 12, 17, 0}, // main
+        {9, 18, 21, 0, 0}, // for
+        {22, 26, 0, 0, 0}, // sw
+        {19, 28, 0, 0, 0}, // py
+        {22, 11, 0, 0, 0}, // sh
+        {10, 19, 15, 0, 0}, // gpl
+        {16, 12, 23, 0, 0}, // mit
+        {22, 11, 21, 24, 10}, // shrug
+};
+
+static const uint16_t PROGMEM snippet_index[SNIPPET_COUNT] = {
+        0, 8, 33, 44, 62, 85, 110, 134, 142, 151, 203, 224,
+        234, 255, 282, 305, 334, 355, 370, 649, 852,
+};
+
+static const uint8_t PROGMEM snippet_pairs[126][2] = {
+        {0x65, 0x20}, {0x20, 0x74}, {0x69, 0x6E}, {0x61, 0x72}, {0x69, 0x74}, {0x2C, 0x20},
+        {0x65, 0x72}, {0x81, 0x68}, {0x69, 0x73}, {0x6F, 0x66}, {0x6F, 0x6E}, {0x87, 0x80},
+        {0x61, 0x6E}, {0x65, 0x6E}, {0x74, 0x20}, {0x72, 0x65}, {0x69, 0x63}, {0x69, 0x8A},
+        {0x6F, 0x72}, {0x6F, 0x75}, {0x6F, 0x20}, {0x75, 0x62}, {0x77, 0x83}, {0x0A, 0x0A},
+        {0x64, 0x20}, {0x73, 0x65}, {0x81, 0x94}, {0x88, 0x20}, {0x6C, 0x20}, {0x74, 0x96},
+        {0x79, 0x20}, {0x84, 0x68}, {0x89, 0x9D}, {0x92, 0x20}, {0x63, 0x6F}, {0x65, 0x98},
+        {0x73, 0x20}, {0x90, 0x8D}, {0x95, 0x6C}, {0x2F, 0x2F}, {0x3A, 0x0A}, {0x53, 0xA0},
+        {0x61, 0x74}, {0x61, 0x9C}, {0x64, 0x65}, {0x69, 0x66}, {0x82, 0x67}, {0x84, 0x20},
+        {0x86, 0x73}, {0x29, 0x0A}, {0x4C, 0xA5}, {0x5F, 0x5F}, {0x61, 0x6D}, {0x61, 0x76},
+        {0x61, 0x82}, {0x62, 0x75}, {0x63, 0x68}, {0x67, 0x72}, {0x68, 0x74}, {0x6F, 0x64},
+        {0x70, 0x72}, {0x72, 0x69}, {0x73, 0x80}, {0x77, 0x9F}, {0x89, 0x8B}, {0xA2, 0x70},
+        {0x0A, 0x7D}, {0x20, 0x47}, {0x20, 0x6E}, {0x20, 0x9B}, {0x20, 0xB2}, {0x20, 0xBF},
+        {0x2E, 0x20}, {0x3A, 0xA7}, {0x41, 0x4E}, {0x41, 0x52}, {0x47, 0x4E}, {0x49, 0x54},
+        {0x50, 0xA6}, {0x54, 0x68}, {0x55, 0xC3}, {0x61, 0x6B}, {0x63, 0x74}, {0x64, 0x88},
+        {0x65, 0x85}, {0x68, 0xB5}, {0x69, 0x6C}, {0x6D, 0xB6}, {0x6F, 0x62}, {0x6F, 0x63},
+        {0x6F, 0x74}, {0x6F, 0xB9}, {0x70, 0x73}, {0x74, 0x68}, {0x74, 0xBD}, {0x82, 0x8E},
+        {0x83, 0x67}, {0x86, 0x6D}, {0x86, 0xAB}, {0x88, 0x68}, {0x8C, 0x64}, {0x8D, 0xE2},
+        {0x8F, 0x80}, {0x90, 0xC6}, {0x93, 0x72}, {0x93, 0x8E}, {0x99, 0x85}, {0x9B, 0xBC},
+        {0xA8, 0x09}, {0xA9, 0x80}, {0xAA, 0x91}, {0xAC, 0x66}, {0xB0, 0x91}, {0xB1, 0x7B},
+        {0xB7, 0x74}, {0xBA, 0x74}, {0xC2, 0x0A}, {0xCC, 0xD0}, {0xCE, 0xE7}, {0xD3, 0xDE},
+        {0xDB, 0xB4}, {0xE5, 0xF6}, {0xEB, 0xF8}, {0xF5, 0xF9}, {0xF7, 0xF2}, {0xFB, 0xBE},
+};
+
+static const uint8_t PROGMEM snippet_text[862] = {
+        0x01, 0x2F, 0x02, 0x20, 0x40, 0x20, 0x03, 0x00, 0xF3, 0xDC, 0xC9, 0x67,
+        0x9F, 0x95, 0x2E, 0xA2, 0x6D, 0x2F, 0x71, 0x6D, 0x6B, 0x2F, 0x71, 0x6D,
+        0x6B, 0x5F, 0x66, 0x69, 0x72, 0x6D, 0x96, 0x65, 0x00, 0xF3, 0xDC, 0xC9,
+        0x67, 0x9F, 0x95, 0x2E, 0xA2, 0x6D, 0x2F, 0x00, 0xCF, 0x8C, 0x6B, 0x73,
+        0x2C, 0x0A, 0x48, 0x65, 0x83, 0x74, 0x52, 0xD8, 0xDA, 0x4E, 0x82, 0x6A,
+        0x61, 0x00, 0x42, 0x65, 0x73, 0x8E, 0x8F, 0x67, 0x83, 0x64, 0x73, 0x2C,
+        0x0A, 0x48, 0x65, 0x83, 0x74, 0x52, 0xD8, 0xDA, 0x4E, 0x82, 0x6A, 0x61,
+        0x00, 0x4C, 0x6F, 0x6F, 0x6B, 0xA4, 0x67, 0x6F, 0xBB, 0x9A, 0x6D, 0x65,
+        0x2C, 0x87, 0x8C, 0x6B, 0xA4, 0x66, 0x92, 0x8B, 0xB8, 0x8C, 0x67, 0x65,
+        0x21, 0x00, 0x6E, 0x84, 0x3A, 0xC4, 0x6F, 0x8E, 0x62, 0x6C, 0xD9, 0x6B,
+        0xAE, 0x2C, 0x81, 0xD1, 0x80, 0xAF, 0xA1, 0x6C, 0x65, 0xB5, 0x80, 0x84,
+        0x2E, 0x00, 0xA7, 0x20, 0x54, 0x4F, 0x44, 0x4F, 0x3A, 0x00, 0xA7, 0x20,
+        0x46, 0x49, 0x58, 0x4D, 0x45, 0x3A, 0x00, 0x53, 0x74, 0x65, 0xDC, 0x9A,
+        0x8F, 0xBC, 0xBB, 0x75, 0x63, 0x65, 0xA8, 0x31, 0xC8, 0x97, 0x45, 0x78,
+        0x70, 0x65, 0xD2, 0xA3, 0x62, 0x65, 0xD5, 0x69, 0xE8, 0x3A, 0x97, 0x41,
+        0xD2, 0x75, 0xAB, 0x62, 0x65, 0xD5, 0x69, 0xE8, 0x3A, 0x97, 0x56, 0xF0,
+        0x3A, 0x20, 0x01, 0x2F, 0x02, 0x20, 0x40, 0x20, 0x03, 0x0A, 0x00, 0x23,
+        0x23, 0x20, 0x53, 0x75, 0x6D, 0x6D, 0x83, 0x79, 0x97, 0x0A, 0x23, 0x23,
+        0x20, 0x54, 0x65, 0x73, 0x74, 0xAE, 0x97, 0x00, 0x23, 0x82, 0x63, 0x6C,
+        0x75, 0x64, 0x80, 0x22, 0x22, 0x00, 0x23, 0xAD, 0x6E, 0xEF, 0x20, 0x5F,
+        0x48, 0x0A, 0x23, 0xEF, 0x82, 0x80, 0x5F, 0x48, 0x97, 0x23, 0x8D, 0x64,
+        0xAD, 0x0A, 0x00, 0xDF, 0xD7, 0x28, 0xDF, 0xE0, 0x63, 0x85, 0xB8, 0x83,
+        0x20, 0x2A, 0x2A, 0xE0, 0x76, 0xF1, 0x0A, 0x09, 0x8F, 0x74, 0x75, 0x72,
+        0x6E, 0x20, 0x30, 0x3B, 0xF4, 0x00, 0x66, 0xA1, 0x28, 0xDF, 0x69, 0x20,
+        0x3D, 0x20, 0x30, 0x3B, 0x20, 0x69, 0x20, 0x3C, 0xC4, 0x3B, 0x20, 0x69,
+        0x2B, 0x2B, 0xF1, 0xF4, 0x00, 0x73, 0x77, 0x84, 0xB8, 0x20, 0x28, 0xF1,
+        0x0A, 0x63, 0x61, 0xBE, 0xEC, 0x62, 0x8F, 0xD1, 0x3B, 0x0A, 0xEF, 0x61,
+        0x75, 0x6C, 0x74, 0xEC, 0x62, 0x8F, 0xD1, 0x3B, 0xF4, 0x00, 0xAD, 0x20,
+        0xB3, 0x6E, 0xB4, 0x65, 0xB3, 0x20, 0x3D, 0x3D, 0x20, 0x22, 0xB3, 0xD7,
+        0xB3, 0x22, 0xEC, 0xD7, 0x28, 0xB1, 0x00, 0x23, 0x21, 0x2F, 0x62, 0x82,
+        0x2F, 0x73, 0x68, 0x0A, 0x99, 0x8E, 0x2D, 0x65, 0x0A, 0x00, 0xCF, 0xFA,
+        0xC5, 0x66, 0xE6, 0x73, 0xA0, 0x65, 0x3A, 0x20, 0x79, 0x93, 0x20, 0x63,
+        0x8C, 0x20, 0x8F, 0xFC, 0x80, 0xAF, 0xE4, 0x2F, 0xA1, 0x6D, 0xBB, 0xAD,
+        0x9E, 0xAF, 0x75, 0x6E, 0x64, 0x86, 0x8B, 0x74, 0xE1, 0xA4, 0xC0, 0xFD,
+        0x61, 0xA4, 0x70, 0xA6, 0xE3, 0xA3, 0x62, 0x79, 0x8B, 0x46, 0xE6, 0xED,
+        0x46, 0x93, 0x6E, 0x64, 0xEE, 0x85, 0x65, 0x9F, 0x86, 0x20, 0x76, 0xF0,
+        0x20, 0x32, 0x20, 0xC0, 0xB2, 0xEA, 0xA1, 0x28, 0x61, 0x8E, 0x79, 0xE8,
+        0x20, 0x6F, 0x70, 0x74, 0x91, 0x29, 0x20, 0x8C, 0x9E, 0x6C, 0xAA, 0x86,
+        0x20, 0x76, 0xF0, 0x2E, 0x97, 0xCF, 0xFA, 0xC5, 0xFC, 0xA3, 0x82, 0x8B,
+        0x68, 0x6F, 0x70, 0x80, 0xDD, 0x61, 0x8E, 0xAF, 0x77, 0xD6, 0x9C, 0x62,
+        0x80, 0x75, 0x99, 0x66, 0x75, 0x6C, 0x85, 0xB7, 0x8E, 0x57, 0xCD, 0x48,
+        0x4F, 0x55, 0x54, 0x20, 0xCA, 0x59, 0x20, 0x57, 0xCB, 0x52, 0xCA, 0x54,
+        0x59, 0x3B, 0xC7, 0xE9, 0x65, 0x76, 0x8D, 0x8B, 0x69, 0x6D, 0x70, 0x6C,
+        0x69, 0xA3, 0x96, 0x72, 0x8C, 0x74, 0x9E, 0x89, 0x20, 0x4D, 0x45, 0x52,
+        0x43, 0x48, 0xCA, 0x54, 0x41, 0x42, 0x49, 0x4C, 0xCD, 0x59, 0x20, 0xA1,
+        0x46, 0xCD, 0x4E, 0x45, 0x53, 0x53, 0x20, 0x46, 0x4F, 0x52, 0x20, 0x41,
+        0x20, 0x50, 0xCB, 0x54, 0x49, 0x43, 0x55, 0x4C, 0xCB, 0x20, 0x50, 0x55,
+        0x52, 0x50, 0x4F, 0x53, 0x45, 0xC8, 0x53, 0x65, 0x80, 0xDD, 0x80, 0xFD,
+        0x66, 0xA1, 0x6D, 0x92, 0x80, 0xAC, 0x74, 0x61, 0xD6, 0x73, 0x2E, 0x97,
+        0x59, 0x93, 0x20, 0x73, 0x68, 0x93, 0x6C, 0x98, 0xD5, 0x80, 0x8F, 0x63,
+        0x65, 0x69, 0x76, 0xA3, 0x61, 0x20, 0xC1, 0x9E, 0xC0, 0xFD, 0x61, 0x6C,
+        0x8A, 0x67, 0xC7, 0x87, 0xFA, 0xC8, 0x49, 0x66, 0xC4, 0xDA, 0x85, 0x99,
+        0x80, 0x3C, 0xF3, 0x70, 0xC9, 0x77, 0x77, 0x77, 0x2E, 0x67, 0x6E, 0x75,
+        0x2E, 0x92, 0x67, 0x2F, 0x6C, 0xA5, 0x99, 0x73, 0x2F, 0x3E, 0x2E, 0x0A,
+        0x00, 0x50, 0xE1, 0x88, 0x73, 0x91, 0xC5, 0x68, 0x86, 0x65, 0x62, 0x9E,
+        0xB9, 0x8C, 0x74, 0x65, 0x64, 0x85, 0x66, 0xE6, 0x89, 0x20, 0xB8, 0xE0,
+        0x65, 0x2C, 0x9A, 0x8C, 0x9E, 0x70, 0xB0, 0x8A, 0x20, 0xD8, 0x74, 0xB6,
+        0xAE, 0x20, 0x61, 0x20, 0xC1, 0x9E, 0x89, 0x87, 0x9B, 0x73, 0xA0, 0x80,
+        0x8C, 0x98, 0x61, 0x73, 0x73, 0xD9, 0x69, 0xAA, 0xA3, 0x64, 0xD9, 0x75,
+        0x6D, 0x8D, 0x74, 0xEE, 0x20, 0x66, 0xD6, 0x65, 0xA4, 0x28, 0xDD, 0x80,
+        0x22, 0xA9, 0x65, 0x22, 0x29, 0x2C, 0x9A, 0xAC, 0xAB, 0x82, 0x8B, 0xED,
+        0xBF, 0xE9, 0x8F, 0x73, 0x74, 0x72, 0x90, 0x74, 0x91, 0x85, 0x82, 0x63,
+        0x6C, 0x75, 0x64, 0xAE, 0xC7, 0xE9, 0x6C, 0x69, 0x6D, 0x84, 0xEE, 0x8B,
+        0xBD, 0x67, 0xBA, 0x73, 0x9A, 0x75, 0xEA, 0xC1, 0x79, 0x85, 0x6D, 0xBB,
+        0xAD, 0x79, 0x85, 0x6D, 0x86, 0x67, 0xD4, 0x70, 0xA6, 0xE3, 0x85, 0xFC,
+        0xD4, 0x73, 0xA6, 0xA5, 0xEA, 0xE4, 0x2F, 0xA1, 0x99, 0x6C, 0x9C, 0xC1,
+        0x69, 0x65, 0xA4, 0xC0, 0xA9, 0xD4, 0xE4, 0x9A, 0x70, 0xE1, 0xAF, 0x70,
+        0xB0, 0x8A, 0x73, 0x9A, 0x77, 0x68, 0x6F, 0x6D, 0x8B, 0xED, 0x9B, 0x66,
+        0x75, 0x72, 0x6E, 0xE3, 0x65, 0x64, 0x9A, 0x64, 0x94, 0x73, 0x6F, 0x85,
+        0x73, 0x95, 0x6A, 0x65, 0xD2, 0x81, 0x6F, 0x8B, 0x66, 0x6F, 0x6C, 0x6C,
+        0x6F, 0x77, 0xAE, 0x20, 0x63, 0x8A, 0x64, 0x84, 0x91, 0x73, 0xA8, 0x00,
+        0x5C, 0x5F, 0x28, 0x6F, 0x5F, 0x6F, 0x29, 0x5F, 0x2F, 0x00,
+};
+
+#endif
+
+#endif
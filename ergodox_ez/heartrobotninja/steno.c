@@ -0,0 +1,131 @@
+#include <string.h>
+#include "steno.h"
+#include "virtser.h"
+
+#define GEMINI_SIZE 6 // bytes in a GeminiPR packet, more than TX Bolt's 5
+#define GEMINI_START 0x80
+
+/* TX Bolt byte for each key: its group in the top two bits and its bit in
+ * the group below. Both S keys, all four stars and the number bar share a
+ * key; the keys TX Bolt lacks are 0.
+ */
+#define BOLT(group, bit) (((group) << 6) | (1 << (bit)))
+#define BOLT_NUM BOLT(3, 4)
+#define BOLT_STAR BOLT(1, 3)
+
+static const uint8_t PROGMEM bolt_keys[STN__MAX - STN__MIN + 1] = {
+        // Fn, #1-#6
+        0, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, 0,
+        // S1- S2- T- K- P- W- H-
+        BOLT(0, 0), BOLT(0, 0), BOLT(0, 1), BOLT(0, 2), BOLT(0, 3), BOLT(0, 4), BOLT(0, 5), 0,
+        // R- A- O- *1 *2 res1 res2
+        BOLT(1, 0), BOLT(1, 1), BOLT(1, 2), BOLT_STAR, BOLT_STAR, 0, 0, 0,
+        // pwr *3 *4 -E -U -F -R
+        0, BOLT_STAR, BOLT_STAR, BOLT(1, 4), BOLT(1, 5), BOLT(2, 0), BOLT(2, 1), 0,
+        // -P -B -L -G -T -S -D
+        BOLT(2, 2), BOLT(2, 3), BOLT(2, 4), BOLT(2, 5), BOLT(3, 0), BOLT(3, 1), BOLT(3, 2), 0,
+        // #7-#C, -Z
+        BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT(3, 3)};
+
+static bool bolt;
+static uint8_t chord[GEMINI_SIZE]; // GeminiPR bytes, or TX Bolt's by group
+static matrix_row_t held[MATRIX_ROWS];
+static uint8_t held_count;
+
+static uint8_t queue[STENO_QUEUE];
+static uint8_t queue_head;
+static uint8_t queue_tail;
+
+static void queue_byte(uint8_t byte)
+{
+  queue[queue_head++ & (STENO_QUEUE - 1)] = byte;
+}
+
+static void send_chord(void)
+{
+  // A host that isn't reading loses whole chords, never part of one
+  if (STENO_QUEUE - (uint8_t)(queue_head - queue_tail) >= GEMINI_SIZE)
+  {
+    if (bolt)
+    {
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        if (chord[i])
+        {
+          queue_byte(chord[i]);
+        }
+      }
+      // Ends the stroke: its group is never past the last byte's
+      queue_byte(0);
+    }
+    else
+    {
+      queue_byte(chord[0] | GEMINI_START);
+      for (uint8_t i = 1; i < GEMINI_SIZE; i++)
+      {
+        queue_byte(chord[i]);
+      }
+    }
+  }
+  memset(chord, 0, sizeof(chord));
+}
+
+bool process_steno_keys(uint16_t keycode, keyrecord_t *record)
+{
+  uint8_t row = record->event.key.row;
+  matrix_row_t col = (matrix_row_t)1 << record->event.key.col;
+
+  if (!record->event.pressed)
+  {
+    if (!(held[row] & col))
+    {
+      return true;
+    }
+    held[row] &= ~col;
+    if (!--held_count)
+    {
+      send_chord();
+    }
+    return false;
+  }
+
+  switch (keycode)
+  {
+  case STN_GEMINI:
+  case STN_BOLT:
+    bolt = keycode == STN_BOLT;
+    memset(chord, 0, sizeof(chord));
+    return false;
+  case STN__MIN ... STN__MAX:
+    break;
+  default:
+    return true;
+  }
+
+  uint8_t key = keycode - STN__MIN;
+  if (bolt)
+  {
+    uint8_t byte = pgm_read_byte(&bolt_keys[key]);
+    chord[byte >> 6] |= byte;
+  }
+  else
+  {
+    chord[key >> 3] |= 0x40 >> (key & 7);
+  }
+  held[row] |= col;
+  held_count++;
+  return false;
+}
+
+bool steno_pending(void)
+{
+  return queue_tail != queue_head;
+}
+
+void steno_task(void)
+{
+  if (queue_tail != queue_head)
+  {
+    virtser_send(queue[queue_tail++ & (STENO_QUEUE - 1)]);
+  }
+}
@@ -0,0 +1,85 @@
+#ifndef STENO_H
+#define STENO_H
+
+#include "quantum.h"
+
+/* Steno chords over virtual serial
+ *
+ * The STN_* keys on the STENO layer add to one chord while any of them is
+ * held, and the chord goes out when the last one is released, in either
+ * serial protocol Plover and the other open steno engines read: GeminiPR,
+ * 6 bytes covering every key, or TX Bolt, a byte per group of keys in use
+ * and a 0. STN_GEMINI and STN_BOLT pick between them, GeminiPR to start.
+ * VIRTSER_ENABLE in rules.mk gives the board the serial port.
+ *
+ * A press or release is a fixed few steps whatever the chord: the chord is
+ * kept packed in the protocol's own bytes, and the keys down are a bit per
+ * matrix position, so a release finds its key even after a layer change.
+ * virtser_send() can wait on the host, so the chord is queued and
+ * steno_task() sends one byte per scan.
+ */
+
+#ifndef STENO_QUEUE
+#define STENO_QUEUE 16 // power of two, at least 6
+#endif
+
+/* A key's value is 8 * its byte in a GeminiPR packet + its bit, first key
+ * at 0x40, which the chord is built from directly.
+ */
+enum steno_keycodes
+{
+  STN__MIN = SAFE_RANGE,
+  STN_FN = STN__MIN,
+  STN_N1,
+  STN_N2,
+  STN_N3,
+  STN_N4,
+  STN_N5,
+  STN_N6,
+  STN_S1 = STN__MIN + 8,
+  STN_S2,
+  STN_TL,
+  STN_KL,
+  STN_PL,
+  STN_WL,
+  STN_HL,
+  STN_RL = STN__MIN + 16,
+  STN_A,
+  STN_O,
+  STN_ST1,
+  STN_ST2,
+  STN_RE1,
+  STN_RE2,
+  STN_PWR = STN__MIN + 24,
+  STN_ST3,
+  STN_ST4,
+  STN_E,
+  STN_U,
+  STN_FR,
+  STN_RR,
+  STN_PR = STN__MIN + 32,
+  STN_BR,
+  STN_LR,
+  STN_GR,
+  STN_TR,
+  STN_SR,
+  STN_DR,
+  STN_N7 = STN__MIN + 40,
+  STN_N8,
+  STN_N9,
+  STN_NA,
+  STN_NB,
+  STN_NC,
+  STN_ZR,
+  STN__MAX = STN_ZR,
+
+  STN_GEMINI = STN__MIN + 48,
+  STN_BOLT,
+  STENO_SAFE_RANGE,
+};
+
+bool process_steno_keys(uint16_t keycode, keyrecord_t *record);
+bool steno_pending(void); // chord bytes still to send
+void steno_task(void);    // call once per scan
+
+#endif
@@ -0,0 +1,252 @@
+#include "unicode_input.h"
+#include "host.h"
+
+/* A character goes out as a list of strokes, each a key with the modifiers
+ * it needs. Strokes are rolled: one report releases the previous stroke and
+ * presses the next, which the host reads as release-then-press. That is one
+ * report per stroke instead of two, plus a release after a repeat and one at
+ * the end.
+ */
+
+#define UNI_MAX_STROKES 12 // NumLock, Alt + 7 decimal digits, NumLock
+
+typedef struct
+{
+  uint8_t mods;
+  uint8_t key;
+} uni_stroke_t;
+
+static uni_stroke_t strokes[UNI_MAX_STROKES];
+static uint8_t stroke_count;
+
+/* Characters with a sequence shorter than the method's hex input */
+enum
+{
+  UNI_UMLAUT,
+  UNI_SHARP_S,
+};
+
+typedef struct
+{
+  uint16_t code_point;
+  uint8_t accent;
+  uint8_t mods;
+  uint8_t key;
+} uni_short_t;
+
+static const uni_short_t PROGMEM uni_shorts[] = {
+        {0x00C4, UNI_UMLAUT, MOD_BIT(KC_LSFT), KC_A},
+        {0x00D6, UNI_UMLAUT, MOD_BIT(KC_LSFT), KC_O},
+        {0x00DC, UNI_UMLAUT, MOD_BIT(KC_LSFT), KC_U},
+        {0x00DF, UNI_SHARP_S, 0, KC_S},
+        {0x00E4, UNI_UMLAUT, 0, KC_A},
+        {0x00F6, UNI_UMLAUT, 0, KC_O},
+        {0x00FC, UNI_UMLAUT, 0, KC_U},
+};
+
+static void push(uint8_t mods, uint8_t key)
+{
+  strokes[stroke_count].mods = mods;
+  strokes[stroke_count].key = key;
+  stroke_count++;
+}
+
+static uint8_t digit_key(uint8_t d, bool keypad)
+{
+  if (d >= 10)
+  {
+    return KC_A + d - 10;
+  }
+  if (keypad)
+  {
+    return d == 0 ? KC_KP_0 : KC_KP_1 + d - 1;
+  }
+  return d == 0 ? KC_0 : KC_1 + d - 1;
+}
+
+static void push_hex(uint8_t mods, uint32_t value, uint8_t digits, bool keypad)
+{
+  for (int8_t shift = (digits - 1) * 4; shift >= 0; shift -= 4)
+  {
+    push(mods, digit_key((value >> shift) & 0xF, keypad));
+  }
+}
+
+static void push_decimal(uint8_t mods, uint32_t value)
+{
+  uint32_t place = 1;
+  while (place * 10 <= value)
+  {
+    place *= 10;
+  }
+  for (; place; place /= 10)
+  {
+    push(mods, digit_key(value / place % 10, true));
+  }
+}
+
+static uint8_t hex_digits(uint32_t value)
+{
+  uint8_t n = 1;
+  while (value >>= 4)
+  {
+    n++;
+  }
+  return n;
+}
+
+static void send_strokes(void)
+{
+  uni_stroke_t prev = {0, KC_NO};
+
+  for (uint8_t i = 0; i < stroke_count; i++)
+  {
+    uni_stroke_t s = strokes[i];
+    if (i > 0 && s.mods == prev.mods && s.key == prev.key)
+    {
+      // A repeat only registers after a release
+      if (prev.key != KC_NO)
+      {
+        del_key(prev.key);
+      }
+      else
+      {
+        del_weak_mods(prev.mods);
+      }
+      send_keyboard_report();
+    }
+    del_weak_mods(prev.mods);
+    if (prev.key != KC_NO)
+    {
+      del_key(prev.key);
+    }
+    add_weak_mods(s.mods);
+    if (s.key != KC_NO)
+    {
+      add_key(s.key);
+    }
+    send_keyboard_report();
+    prev = s;
+  }
+  del_weak_mods(prev.mods);
+  if (prev.key != KC_NO)
+  {
+    del_key(prev.key);
+  }
+  send_keyboard_report();
+  stroke_count = 0;
+}
+
+static bool push_short(uint8_t method, uint32_t code_point)
+{
+  if (method != UNI_OSX && method != UNI_WINCOMPOSE && method != UNI_LINUX)
+  {
+    return false;
+  }
+  for (uint8_t i = 0; i < sizeof(uni_shorts) / sizeof(uni_shorts[0]); i++)
+  {
+    if (pgm_read_word(&uni_shorts[i].code_point) != code_point)
+    {
+      continue;
+    }
+    uint8_t accent = pgm_read_byte(&uni_shorts[i].accent);
+    uint8_t mods = pgm_read_byte(&uni_shorts[i].mods);
+    uint8_t key = pgm_read_byte(&uni_shorts[i].key);
+
+    if (method == UNI_OSX)
+    {
+      if (accent == UNI_UMLAUT)
+      {
+        push(MOD_BIT(KC_RALT) | MOD_BIT(KC_RSFT), KC_SCLN);
+        push(mods, key);
+      }
+      else
+      {
+        push(MOD_BIT(KC_RALT), key);
+      }
+    }
+    else
+    {
+      // X11 compose sequences; WinCompose reads the same ones
+      push(MOD_BIT(KC_RALT), KC_NO);
+      if (accent == UNI_UMLAUT)
+      {
+        push(MOD_BIT(KC_LSFT), KC_QUOT);
+        push(mods, key);
+      }
+      else
+      {
+        push(0, key);
+        push(0, key);
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+static void push_hex_input(uint8_t method, uint32_t code_point)
+{
+  switch (method)
+  {
+  case UNI_WIN_ALTCODE:
+    // A leading 0 picks code page 1252, which is Latin-1 from U+00A0 up
+    if (code_point <= 0xFF)
+    {
+      push(MOD_BIT(KC_LALT), KC_KP_0);
+    }
+    push_decimal(MOD_BIT(KC_LALT), code_point);
+    break;
+  case UNI_WIN_HEX:
+    push(MOD_BIT(KC_LALT), KC_KP_PLUS);
+    push_hex(MOD_BIT(KC_LALT), code_point, hex_digits(code_point), true);
+    break;
+  case UNI_WINCOMPOSE:
+    push(MOD_BIT(KC_RALT), KC_NO);
+    push(0, KC_U);
+    push_hex(0, code_point, hex_digits(code_point), false);
+    push(0, KC_ENT);
+    break;
+  case UNI_OSX:
+    // Unicode Hex Input takes UTF-16, four digits per unit, Option held
+    if (code_point > 0xFFFF)
+    {
+      code_point -= 0x10000;
+      push_hex(MOD_BIT(KC_LALT), 0xD800 | (code_point >> 10), 4, false);
+      push_hex(MOD_BIT(KC_LALT), 0xDC00 | (code_point & 0x3FF), 4, false);
+    }
+    else
+    {
+      push_hex(MOD_BIT(KC_LALT), code_point, 4, false);
+    }
+    break;
+  case UNI_LINUX:
+    push(MOD_BIT(KC_LCTL) | MOD_BIT(KC_LSFT), KC_U);
+    push_hex(0, code_point, hex_digits(code_point), false);
+    push(0, KC_SPC);
+    break;
+  }
+}
+
+void uni_send(uint8_t method, uint32_t code_point)
+{
+  if (code_point > 0x10FFFF)
+  {
+    return;
+  }
+  bool numpad = method == UNI_WIN_ALTCODE || method == UNI_WIN_HEX;
+  bool numlock_off = numpad && !(host_keyboard_leds() & (1 << USB_LED_NUM_LOCK));
+  if (numlock_off)
+  {
+    push(0, KC_NLCK);
+  }
+  if (!push_short(method, code_point))
+  {
+    push_hex_input(method, code_point);
+  }
+  if (numlock_off)
+  {
+    push(0, KC_NLCK);
+  }
+  send_strokes();
+}
@@ -0,0 +1,45 @@
+#ifndef UNICODE_INPUT_H
+#define UNICODE_INPUT_H
+
+#include "quantum.h"
+
+/* Unicode output
+ *
+ * uni_send() types any code point with the input method the user picked,
+ * using the shortest report sequence that method offers for the character:
+ *
+ *   UNI_WIN_ALTCODE  Hold Alt and type the decimal code on the numpad: with
+ *                    a leading 0 (code page 1252) up to U+00FF, without one
+ *                    above, which only RichEdit programs (WordPad, Outlook)
+ *                    read as Unicode. Works on a stock Windows install.
+ *   UNI_WIN_HEX      Hold Alt, numpad +, the hex code (numpad digits,
+ *                    letters for a-f). Built into Windows, but needs the
+ *                    EnableHexNumpad registry value set to "1" under
+ *                    HKCU\Control Panel\Input Method and a new login.
+ *   UNI_WINCOMPOSE   Compose (RAlt) followed by its X11 sequence when one
+ *                    is known, otherwise Compose u <hex> Enter. Needs
+ *                    WinCompose running with its default compose key.
+ *   UNI_OSX          Dead key when one is known, otherwise hold Option and
+ *                    type the UTF-16 hex. Needs the "Unicode Hex Input"
+ *                    input source.
+ *   UNI_LINUX        Compose (RAlt) sequence when one is known, otherwise
+ *                    Ctrl+Shift+U <hex> Space (GTK and IBus).
+ *
+ * The two numpad methods need NumLock on. When the host's NumLock LED is
+ * off they turn it on for the character and off again after, so the host
+ * keeps the lock state it had. Every code point is a short fixed burst; see
+ * sim/build/unicode_cost for reports and time per character.
+ */
+
+enum
+{
+  UNI_WIN_ALTCODE = 0,
+  UNI_WIN_HEX,
+  UNI_WINCOMPOSE,
+  UNI_OSX,
+  UNI_LINUX,
+};
+
+void uni_send(uint8_t method, uint32_t code_point);
+
+#endif
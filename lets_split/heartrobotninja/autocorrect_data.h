@@ -0,0 +1,125 @@
+// Generated by sim/build/autocorrect_gen from autocorrect_dict.txt, do not edit
+// 82 entries, 1347 bytes
+
+#ifndef AUTOCORRECT_DATA_H
+#define AUTOCORRECT_DATA_H
+
+#define AUTOCORRECT_MAX_LENGTH 12
+
+static const uint8_t PROGMEM autocorrect_data[1347] = {
+        0x40, 0x07, 0x2F, 0x00, 0x08, 0xA7, 0x00, 0x09, 0x80, 0x01, 0x0A, 0x8B,
+        0x01, 0x0B, 0xAC, 0x01, 0x0F, 0xC8, 0x01, 0x11, 0xE3, 0x01, 0x12, 0x00,
+        0x02, 0x15, 0x1C, 0x02, 0x16, 0x5C, 0x02, 0x17, 0xB5, 0x02, 0x18, 0x2E,
+        0x03, 0x1A, 0x38, 0x03, 0x1C, 0x68, 0x03, 0x2C, 0x0E, 0x04, 0x00, 0x40,
+        0x08, 0x3A, 0x00, 0x11, 0x59, 0x00, 0x15, 0x65, 0x00, 0x00, 0x40, 0x15,
+        0x42, 0x00, 0x17, 0x4D, 0x00, 0x00, 0x18, 0x06, 0x06, 0x12, 0x2C, 0x00,
+        0x81, 0x15, 0x08, 0x07, 0x00, 0x0C, 0x10, 0x10, 0x12, 0x06, 0x2C, 0x00,
+        0x81, 0x17, 0x08, 0x07, 0x00, 0x0C, 0x08, 0x15, 0x09, 0x2C, 0x00, 0x83,
+        0x0C, 0x08, 0x11, 0x07, 0x00, 0x40, 0x04, 0x70, 0x00, 0x08, 0x90, 0x00,
+        0x12, 0x9A, 0x00, 0x00, 0x40, 0x05, 0x78, 0x00, 0x1A, 0x85, 0x00, 0x00,
+        0x12, 0x1C, 0x08, 0x0E, 0x2C, 0x00, 0x84, 0x05, 0x12, 0x04, 0x15, 0x07,
+        0x00, 0x12, 0x09, 0x2C, 0x00, 0x83, 0x15, 0x1A, 0x04, 0x15, 0x07, 0x00,
+        0x0C, 0x1A, 0x2C, 0x00, 0x83, 0x08, 0x0C, 0x15, 0x07, 0x00, 0x04, 0x05,
+        0x1C, 0x08, 0x0E, 0x2C, 0x00, 0x83, 0x12, 0x04, 0x15, 0x07, 0x00, 0x40,
+        0x06, 0xB8, 0x00, 0x0F, 0xED, 0x00, 0x16, 0xFB, 0x00, 0x17, 0x1D, 0x01,
+        0x19, 0x3F, 0x01, 0x00, 0x40, 0x0C, 0xC0, 0x00, 0x11, 0xCA, 0x00, 0x00,
+        0x08, 0x13, 0x2C, 0x00, 0x83, 0x0C, 0x08, 0x06, 0x08, 0x00, 0x40, 0x04,
+        0xD2, 0x00, 0x08, 0xDF, 0x00, 0x00, 0x17, 0x16, 0x0C, 0x1B, 0x08, 0x2C,
+        0x00, 0x83, 0x08, 0x11, 0x06, 0x08, 0x00, 0x15, 0x18, 0x06, 0x06, 0x12,
+        0x2C, 0x00, 0x83, 0x15, 0x08, 0x11, 0x06, 0x08, 0x00, 0x05, 0x0C, 0x16,
+        0x12, 0x13, 0x2C, 0x00, 0x83, 0x16, 0x0C, 0x05, 0x0F, 0x08, 0x00, 0x40,
+        0x04, 0x03, 0x01, 0x11, 0x0F, 0x01, 0x00, 0x18, 0x06, 0x08, 0x05, 0x2C,
+        0x00, 0x83, 0x04, 0x18, 0x16, 0x08, 0x00, 0x12, 0x13, 0x08, 0x15, 0x2C,
+        0x00, 0x84, 0x16, 0x13, 0x12, 0x11, 0x16, 0x08, 0x00, 0x04, 0x00, 0x40,
+        0x13, 0x27, 0x01, 0x15, 0x32, 0x01, 0x00, 0x07, 0x18, 0x2C, 0x00, 0x84,
+        0x13, 0x07, 0x04, 0x17, 0x08, 0x00, 0x08, 0x13, 0x08, 0x16, 0x2C, 0x00,
+        0x84, 0x04, 0x15, 0x04, 0x17, 0x08, 0x00, 0x40, 0x08, 0x47, 0x01, 0x0C,
+        0x53, 0x01, 0x00, 0x0C, 0x06, 0x08, 0x15, 0x2C, 0x00, 0x83, 0x08, 0x0C,
+        0x19, 0x08, 0x00, 0x40, 0x08, 0x5B, 0x01, 0x0F, 0x77, 0x01, 0x00, 0x40,
+        0x0B, 0x63, 0x01, 0x0F, 0x6D, 0x01, 0x00, 0x06, 0x04, 0x2C, 0x00, 0x83,
+        0x0C, 0x08, 0x19, 0x08, 0x00, 0x08, 0x05, 0x2C, 0x00, 0x83, 0x0C, 0x08,
+        0x19, 0x08, 0x00, 0x08, 0x05, 0x2C, 0x00, 0x81, 0x08, 0x19, 0x08, 0x00,
+        0x0C, 0x08, 0x0B, 0x06, 0x2C, 0x00, 0x82, 0x0C, 0x08, 0x09, 0x00, 0x11,
+        0x0C, 0x00, 0x40, 0x10, 0x96, 0x01, 0x11, 0xA0, 0x01, 0x00, 0x10, 0x12,
+        0x06, 0x2C, 0x00, 0x83, 0x0C, 0x11, 0x0A, 0x00, 0x0C, 0x0A, 0x08, 0x05,
+        0x2C, 0x00, 0x82, 0x11, 0x0C, 0x11, 0x0A, 0x00, 0x40, 0x0C, 0xB4, 0x01,
+        0x17, 0xBE, 0x01, 0x00, 0x06, 0x0B, 0x1A, 0x2C, 0x00, 0x82, 0x0C, 0x06,
+        0x0B, 0x00, 0x11, 0x08, 0x0F, 0x2C, 0x00, 0x81, 0x0A, 0x17, 0x0B, 0x00,
+        0x40, 0x07, 0xD0, 0x01, 0x08, 0xD9, 0x01, 0x00, 0x18, 0x12, 0x1A, 0x2C,
+        0x00, 0x81, 0x0F, 0x07, 0x00, 0x13, 0x12, 0x08, 0x13, 0x2C, 0x00, 0x81,
+        0x0F, 0x08, 0x00, 0x40, 0x04, 0xEB, 0x01, 0x18, 0xF5, 0x01, 0x00, 0x0C,
+        0x0A, 0x04, 0x2C, 0x00, 0x82, 0x04, 0x0C, 0x11, 0x00, 0x15, 0x17, 0x08,
+        0x15, 0x2C, 0x00, 0x82, 0x18, 0x15, 0x11, 0x00, 0x40, 0x11, 0x08, 0x02,
+        0x1A, 0x14, 0x02, 0x00, 0x0C, 0x17, 0x06, 0x11, 0x18, 0x09, 0x2C, 0x00,
+        0x81, 0x12, 0x11, 0x00, 0x11, 0x0E, 0x2C, 0x00, 0x81, 0x12, 0x1A, 0x00,
+        0x40, 0x04, 0x24, 0x02, 0x08, 0x30, 0x02, 0x00, 0x0C, 0x0F, 0x0C, 0x10,
+        0x0C, 0x16, 0x2C, 0x00, 0x82, 0x04, 0x15, 0x00, 0x40, 0x07, 0x3B, 0x02,
+        0x0C, 0x46, 0x02, 0x17, 0x4F, 0x02, 0x00, 0x11, 0x08, 0x0F, 0x04, 0x06,
+        0x2C, 0x00, 0x81, 0x04, 0x15, 0x00, 0x0B, 0x17, 0x2C, 0x00, 0x82, 0x08,
+        0x0C, 0x15, 0x00, 0x10, 0x04, 0x15, 0x04, 0x13, 0x2C, 0x00, 0x82, 0x08,
+        0x17, 0x08, 0x15, 0x00, 0x40, 0x16, 0x64, 0x02, 0x18, 0xA5, 0x02, 0x00,
+        0x40, 0x04, 0x6F, 0x02, 0x08, 0x7C, 0x02, 0x12, 0x99, 0x02, 0x00, 0x15,
+        0x04, 0x05, 0x10, 0x08, 0x2C, 0x00, 0x82, 0x15, 0x04, 0x16, 0x16, 0x00,
+        0x40, 0x06, 0x84, 0x02, 0x15, 0x8E, 0x02, 0x00, 0x18, 0x16, 0x2C, 0x00,
+        0x82, 0x06, 0x08, 0x16, 0x16, 0x00, 0x07, 0x04, 0x2C, 0x00, 0x83, 0x07,
+        0x15, 0x08, 0x16, 0x16, 0x00, 0x15, 0x06, 0x06, 0x04, 0x2C, 0x00, 0x84,
+        0x15, 0x12, 0x16, 0x16, 0x00, 0x12, 0x0C, 0x06, 0x11, 0x12, 0x06, 0x2C,
+        0x00, 0x84, 0x16, 0x06, 0x0C, 0x12, 0x18, 0x16, 0x00, 0x40, 0x0B, 0xC0,
+        0x02, 0x11, 0xCA, 0x02, 0x18, 0x25, 0x03, 0x00, 0x0A, 0x11, 0x08, 0x0F,
+        0x2C, 0x00, 0x81, 0x17, 0x0B, 0x00, 0x40, 0x04, 0xD2, 0x02, 0x08, 0xE1,
+        0x02, 0x00, 0x07, 0x11, 0x08, 0x13, 0x08, 0x07, 0x11, 0x0C, 0x2C, 0x00,
+        0x82, 0x08, 0x11, 0x17, 0x00, 0x40, 0x10, 0xE9, 0x02, 0x15, 0x1B, 0x03,
+        0x00, 0x40, 0x08, 0xF4, 0x02, 0x12, 0x00, 0x03, 0x15, 0x0E, 0x03, 0x00,
+        0x18, 0x0A, 0x15, 0x04, 0x2C, 0x00, 0x84, 0x10, 0x08, 0x11, 0x17, 0x00,
+        0x15, 0x0C, 0x19, 0x11, 0x08, 0x2C, 0x00, 0x83, 0x11, 0x10, 0x08, 0x11,
+        0x17, 0x00, 0x08, 0x19, 0x12, 0x0A, 0x2C, 0x00, 0x83, 0x11, 0x10, 0x08,
+        0x11, 0x17, 0x00, 0x18, 0x06, 0x2C, 0x00, 0x82, 0x15, 0x08, 0x11, 0x17,
+        0x00, 0x16, 0x0D, 0x2C, 0x00, 0x82, 0x18, 0x16, 0x17, 0x00, 0x17, 0x12,
+        0x05, 0x04, 0x2C, 0x00, 0x81, 0x18, 0x17, 0x00, 0x40, 0x11, 0x40, 0x03,
+        0x12, 0x49, 0x03, 0x00, 0x12, 0x0E, 0x2C, 0x00, 0x82, 0x11, 0x12, 0x1A,
+        0x00, 0x15, 0x12, 0x10, 0x00, 0x40, 0x10, 0x55, 0x03, 0x12, 0x60, 0x03,
+        0x00, 0x12, 0x17, 0x2C, 0x00, 0x84, 0x12, 0x15, 0x15, 0x12, 0x1A, 0x00,
+        0x17, 0x2C, 0x00, 0x81, 0x15, 0x12, 0x1A, 0x00, 0x40, 0x0F, 0x70, 0x03,
+        0x15, 0xE9, 0x03, 0x00, 0x40, 0x04, 0x7E, 0x03, 0x06, 0x89, 0x03, 0x08,
+        0x95, 0x03, 0x17, 0xB4, 0x03, 0x00, 0x05, 0x12, 0x15, 0x13, 0x2C, 0x00,
+        0x81, 0x05, 0x0F, 0x1C, 0x00, 0x0C, 0x16, 0x04, 0x05, 0x2C, 0x00, 0x81,
+        0x04, 0x0F, 0x0F, 0x1C, 0x00, 0x40, 0x17, 0x9D, 0x03, 0x18, 0xAC, 0x03,
+        0x00, 0x04, 0x11, 0x0C, 0x09, 0x08, 0x07, 0x2C, 0x00, 0x84, 0x0C, 0x17,
+        0x08, 0x0F, 0x1C, 0x00, 0x15, 0x17, 0x2C, 0x00, 0x82, 0x0F, 0x1C, 0x00,
+        0x40, 0x04, 0xBC, 0x03, 0x08, 0xDD, 0x03, 0x00, 0x40, 0x0C, 0xC4, 0x03,
+        0x11, 0xD0, 0x03, 0x00, 0x07, 0x08, 0x10, 0x10, 0x0C, 0x2C, 0x00, 0x81,
+        0x08, 0x0F, 0x1C, 0x00, 0x0C, 0x09, 0x08, 0x07, 0x2C, 0x00, 0x83, 0x0C,
+        0x17, 0x08, 0x0F, 0x1C, 0x00, 0x0F, 0x13, 0x10, 0x12, 0x06, 0x2C, 0x00,
+        0x81, 0x08, 0x0F, 0x1C, 0x00, 0x04, 0x16, 0x00, 0x40, 0x08, 0xF4, 0x03,
+        0x16, 0xFF, 0x03, 0x00, 0x06, 0x08, 0x11, 0x2C, 0x00, 0x82, 0x16, 0x04,
+        0x15, 0x1C, 0x00, 0x08, 0x06, 0x06, 0x08, 0x11, 0x2C, 0x00, 0x86, 0x08,
+        0x16, 0x16, 0x04, 0x15, 0x1C, 0x00, 0x40, 0x07, 0x2B, 0x04, 0x08, 0x37,
+        0x04, 0x0B, 0x62, 0x04, 0x0F, 0x7B, 0x04, 0x11, 0x84, 0x04, 0x12, 0x9B,
+        0x04, 0x16, 0xB0, 0x04, 0x17, 0xC8, 0x04, 0x1C, 0x38, 0x05, 0x00, 0x11,
+        0x08, 0x13, 0x13, 0x04, 0x0B, 0x2C, 0x00, 0xC1, 0x08, 0x07, 0x00, 0x40,
+        0x15, 0x3F, 0x04, 0x17, 0x5A, 0x04, 0x00, 0x40, 0x18, 0x47, 0x04, 0x1C,
+        0x50, 0x04, 0x00, 0x12, 0x1C, 0x2C, 0x00, 0xC2, 0x34, 0x15, 0x08, 0x00,
+        0x08, 0x0B, 0x17, 0x2C, 0x00, 0xC2, 0x34, 0x15, 0x08, 0x00, 0x0B, 0x2C,
+        0x00, 0xC3, 0x17, 0x0B, 0x08, 0x00, 0x40, 0x06, 0x6A, 0x04, 0x08, 0x74,
+        0x04, 0x00, 0x0C, 0x1A, 0x2C, 0x00, 0xC3, 0x0B, 0x0C, 0x06, 0x0B, 0x00,
+        0x17, 0x2C, 0x00, 0xC2, 0x0B, 0x08, 0x00, 0x0F, 0x0C, 0x17, 0x11, 0x18,
+        0x2C, 0x00, 0xC1, 0x00, 0x40, 0x06, 0x8C, 0x04, 0x07, 0x94, 0x04, 0x00,
+        0x04, 0x2C, 0x00, 0xC3, 0x06, 0x04, 0x11, 0x00, 0x04, 0x2C, 0x00, 0xC2,
+        0x11, 0x07, 0x00, 0x40, 0x09, 0xA3, 0x04, 0x18, 0xA9, 0x04, 0x00, 0x2C,
+        0x00, 0xC2, 0x12, 0x09, 0x00, 0x1C, 0x2C, 0x00, 0xC2, 0x12, 0x18, 0x00,
+        0x17, 0x04, 0x0B, 0x00, 0x40, 0x17, 0xBC, 0x04, 0x1A, 0xC2, 0x04, 0x00,
+        0x2C, 0x00, 0xC1, 0x34, 0x16, 0x00, 0x2C, 0x00, 0xC1, 0x34, 0x16, 0x00,
+        0x40, 0x0B, 0xD3, 0x04, 0x11, 0xF8, 0x04, 0x12, 0x32, 0x05, 0x00, 0x40,
+        0x04, 0xDB, 0x04, 0x0C, 0xF1, 0x04, 0x00, 0x40, 0x17, 0xE3, 0x04, 0x1A,
+        0xEA, 0x04, 0x00, 0x2C, 0x00, 0xC3, 0x0B, 0x04, 0x17, 0x00, 0x2C, 0x00,
+        0xC3, 0x0B, 0x04, 0x17, 0x00, 0x1A, 0x2C, 0x00, 0xC2, 0x17, 0x0B, 0x00,
+        0x40, 0x07, 0x03, 0x05, 0x12, 0x0B, 0x05, 0x16, 0x12, 0x05, 0x00, 0x0C,
+        0x07, 0x2C, 0x00, 0xC1, 0x34, 0x17, 0x00, 0x07, 0x2C, 0x00, 0xC1, 0x34,
+        0x17, 0x00, 0x40, 0x04, 0x1D, 0x05, 0x08, 0x24, 0x05, 0x0C, 0x2C, 0x05,
+        0x00, 0x1A, 0x2C, 0x00, 0xC1, 0x34, 0x17, 0x00, 0x12, 0x07, 0x2C, 0x00,
+        0xC1, 0x34, 0x17, 0x00, 0x2C, 0x00, 0xC1, 0x34, 0x17, 0x00, 0x2C, 0x00,
+        0xC2, 0x17, 0x12, 0x00, 0x0F, 0x04, 0x11, 0x0C, 0x09, 0x2C, 0x00, 0xC1,
+        0x0F, 0x1C, 0x00,
+};
+
+#endif
@@ -45,6 +45,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #undef TAPPING_TOGGLE
 #define TAPPING_TOGGLE 2
 
+// Rows 0-3 are the left half, 4-7 the right
+#define HOME_ROW_IS_RIGHT(key) ((key).row >= 4)
+
 #ifdef SUBPROJECT_rev1
 #include "../../rev1/config.h"
 #endif
@@ -0,0 +1,117 @@
+#include <avr/eeprom.h>
+#include "eeconfig.h"
+#include "eeprom_queue.h"
+
+typedef struct
+{
+  uint8_t *addr;
+  uint8_t value;
+} eeq_entry_t;
+
+static eeq_entry_t eeq[EEQ_SIZE];
+static uint8_t eeq_head;
+static uint8_t eeq_count;
+
+static eeq_entry_t *eeq_find(const uint8_t *addr)
+{
+  uint8_t i = eeq_head;
+  for (uint8_t n = eeq_count; n; n--)
+  {
+    if (eeq[i].addr == addr)
+    {
+      return &eeq[i];
+    }
+    i = (i + 1) % EEQ_SIZE;
+  }
+  return NULL;
+}
+
+static void eeq_drain_one(void)
+{
+  eeq_entry_t *e = &eeq[eeq_head];
+  // eeprom_update_byte only starts a write when the stored byte differs
+  eeprom_update_byte(e->addr, e->value);
+  eeq_head = (eeq_head + 1) % EEQ_SIZE;
+  eeq_count--;
+}
+
+void eeq_update_byte(uint8_t *addr, uint8_t value)
+{
+  eeq_entry_t *e = eeq_find(addr);
+  if (e)
+  {
+    // Coalesce: only the newest value for an address ever reaches the EEPROM
+    e->value = value;
+    return;
+  }
+  if (eeq_count == EEQ_SIZE)
+  {
+    // Out of slots, pay for one write now rather than lose one
+    eeprom_busy_wait();
+    eeq_drain_one();
+  }
+  e = &eeq[(eeq_head + eeq_count) % EEQ_SIZE];
+  e->addr = addr;
+  e->value = value;
+  eeq_count++;
+}
+
+void eeq_update_word(uint16_t *addr, uint16_t value)
+{
+  uint8_t *p = (uint8_t *)addr;
+  eeq_update_byte(p, value & 0xFF);
+  eeq_update_byte(p + 1, value >> 8);
+}
+
+void eeq_update_dword(uint32_t *addr, uint32_t value)
+{
+  uint16_t *p = (uint16_t *)addr;
+  eeq_update_word(p, value & 0xFFFF);
+  eeq_update_word(p + 1, value >> 16);
+}
+
+bool eeq_pending(void)
+{
+  return eeq_count != 0;
+}
+
+void eeq_task(void)
+{
+  if (eeq_count && eeprom_is_ready())
+  {
+    eeq_drain_one();
+  }
+}
+
+void eeq_flush(void)
+{
+  while (eeq_count)
+  {
+    eeprom_busy_wait();
+    eeq_drain_one();
+  }
+  eeprom_busy_wait();
+}
+
+/* Mirrors eeconfig_init() from tmk_core/common/eeconfig.c in QMK 0.5 (2017),
+ * which these keymaps build against: the same bytes in the same order. Later
+ * QMK adds fields (EECONFIG_STENOMODE and on), so compare with that function
+ * when moving to a newer QMK.
+ */
+void eeq_config_init(void)
+{
+  eeq_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+  eeq_update_byte(EECONFIG_DEBUG, 0);
+  eeq_update_byte(EECONFIG_DEFAULT_LAYER, 0);
+  eeq_update_byte(EECONFIG_KEYMAP, 0);
+  eeq_update_byte(EECONFIG_MOUSEKEY_ACCEL, 0);
+#ifdef BACKLIGHT_ENABLE
+  eeq_update_byte(EECONFIG_BACKLIGHT, 0);
+#endif
+#ifdef AUDIO_ENABLE
+  eeq_update_byte(EECONFIG_AUDIO, 0xFF);
+#endif
+#ifdef RGBLIGHT_ENABLE
+  eeq_update_dword(EECONFIG_RGBLIGHT, 0);
+#endif
+}
@@ -0,0 +1,198 @@
+#include <string.h>
+#include "journal.h"
+
+#define JOURNAL_MAGIC 0x4A524E4CUL // "JRNL"
+#define LINE_LENGTH 19             // "tttt y aa dddddddd\n"
+
+static struct
+{
+  uint32_t magic;
+  uint8_t head; // next slot, counting up through the ring
+  uint8_t boots;
+  journal_entry_t entries[JOURNAL_SIZE];
+} journal __attribute__((section(".noinit")));
+
+/* Last state journaled, so journal_task only appends changes */
+static uint32_t last_layers;
+static uint8_t last_mods;
+
+/* Dump in progress */
+static uint16_t dump_left; // entries still to type, up to JOURNAL_SIZE
+static uint8_t dump_slot;
+static uint8_t dump_pos;  // character of the entry's line
+static uint8_t dump_held; // key on the wire
+static uint8_t dump_mods; // real and one-shot mods put aside for the dump
+static uint8_t dump_oneshot;
+
+void journal_init(void)
+{
+  if (journal.magic != JOURNAL_MAGIC)
+  {
+    memset(&journal, 0, sizeof(journal));
+    journal.magic = JOURNAL_MAGIC;
+  }
+  else
+  {
+    journal.boots++;
+  }
+  journal_append(JOURNAL_BOOT, journal.boots, 0, timer_read());
+}
+
+void journal_append(uint8_t type, uint8_t arg, uint32_t data, uint16_t time)
+{
+  journal_entry_t *e = &journal.entries[journal.head++ & (JOURNAL_SIZE - 1)];
+  e->time = time;
+  e->type = type;
+  e->arg = arg;
+  e->data = data;
+}
+
+void journal_key(uint16_t keycode, keyrecord_t *record)
+{
+  journal_append(JOURNAL_KEY_UP - record->event.pressed,
+                 record->event.key.row << 4 | record->event.key.col, keycode,
+                 record->event.time);
+}
+
+// Skips the slots nothing was ever written to
+static void dump_skip_empty(void)
+{
+  while (dump_left && journal.entries[dump_slot].type == JOURNAL_NONE)
+  {
+    dump_slot = (dump_slot + 1) & (JOURNAL_SIZE - 1);
+    dump_left--;
+  }
+}
+
+void journal_dump(void)
+{
+  if (dump_left)
+  {
+    return;
+  }
+  dump_slot = journal.head & (JOURNAL_SIZE - 1);
+  dump_left = JOURNAL_SIZE;
+  dump_pos = 0;
+  dump_skip_empty();
+  if (!dump_left)
+  {
+    return;
+  }
+  /* A stuck modifier would turn the dump into shortcuts. The MODS entries
+   * already have them; weak mods have no getter here and only last as long
+   * as the key that set them, so they're just dropped.
+   */
+  dump_mods = get_mods();
+  dump_oneshot = get_oneshot_mods();
+  clear_mods();
+  clear_weak_mods();
+  clear_oneshot_mods();
+}
+
+static uint8_t hex_key(uint8_t nibble)
+{
+  if (!nibble)
+  {
+    return KC_0;
+  }
+  return nibble < 10 ? KC_1 + nibble - 1 : KC_A + nibble - 10;
+}
+
+static uint8_t line_key(const journal_entry_t *e, uint8_t pos)
+{
+  if (pos == LINE_LENGTH - 1)
+  {
+    return KC_ENT;
+  }
+  if (pos == 4 || pos == 6 || pos == 9)
+  {
+    return KC_SPC;
+  }
+  if (pos < 4)
+  {
+    return hex_key(e->time >> (12 - 4 * pos) & 0xF);
+  }
+  if (pos == 5)
+  {
+    return hex_key(e->type & 0xF);
+  }
+  if (pos < 9)
+  {
+    return hex_key(e->arg >> (4 * (8 - pos)) & 0xF);
+  }
+  return hex_key(e->data >> (4 * (17 - pos)) & 0xF);
+}
+
+static void set_held(uint8_t key)
+{
+  if (dump_held != KC_NO)
+  {
+    del_key(dump_held);
+  }
+  if (key != KC_NO)
+  {
+    add_key(key);
+  }
+  dump_held = key;
+  send_keyboard_report();
+}
+
+/* One report per scan, as snippets go out: each releases the last key and
+ * presses the next, except that a key repeated needs a report of its own
+ * to let go first.
+ */
+static void dump_task(void)
+{
+  if (!dump_left)
+  {
+    set_held(KC_NO);
+    if (dump_mods | dump_oneshot)
+    {
+      set_mods(dump_mods);
+      set_oneshot_mods(dump_oneshot);
+      send_keyboard_report();
+    }
+    return;
+  }
+  uint8_t key = line_key(&journal.entries[dump_slot], dump_pos);
+  if (key == dump_held)
+  {
+    set_held(KC_NO);
+    return;
+  }
+  set_held(key);
+  if (++dump_pos == LINE_LENGTH)
+  {
+    dump_pos = 0;
+    dump_slot = (dump_slot + 1) & (JOURNAL_SIZE - 1);
+    dump_left--;
+    dump_skip_empty();
+  }
+}
+
+bool journal_pending(void)
+{
+  return dump_left || dump_held != KC_NO || layer_state != last_layers ||
+         keyboard_report->mods != last_mods;
+}
+
+void journal_task(void)
+{
+  // The dump's own reports aren't journaled
+  if (dump_left || dump_held != KC_NO)
+  {
+    dump_task();
+    return;
+  }
+  if (layer_state != last_layers)
+  {
+    last_layers = layer_state;
+    journal_append(JOURNAL_LAYER, biton32(default_layer_state), layer_state, timer_read());
+  }
+  if (keyboard_report->mods != last_mods)
+  {
+    last_mods = keyboard_report->mods;
+    journal_append(JOURNAL_MODS, last_mods, get_mods() | (uint16_t)get_oneshot_mods() << 8,
+                   timer_read());
+  }
+}
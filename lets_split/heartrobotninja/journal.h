@@ -0,0 +1,60 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "quantum.h"
+
+/* Crash journal
+ *
+ * The last JOURNAL_SIZE key events, layer changes and changes to the
+ * report's modifiers, kept in .noinit RAM. The C runtime leaves that alone
+ * at startup, so after a watchdog or brown-out reset the journal still
+ * holds what led up to it, and journal_init() adds a boot entry after it.
+ * A magic number tells a journal from the garbage RAM holds at power on.
+ *
+ * An append is a handful of stores into a ring: no branch, no lock, and
+ * nothing to wait on, so it can run from an interrupt. One that lands in
+ * the few instructions of another's claim on a slot takes the same slot;
+ * the ring stays whole and one of the two entries is lost.
+ *
+ * journal_dump() types the journal out, oldest first, a line per entry and
+ * one key per scan: "tttt y aa dddddddd", all hex, time in ms, type, arg,
+ * data. Key events are type 1 down and 2 up, arg the matrix row and column
+ * as a nibble each, data the keycode; 3 is layer_state in data with the
+ * default layer in arg, 4 the report's mods in arg with the real and
+ * one-shot mods in data, 5 a boot with the count of them in arg. Mods
+ * are cleared for the dump and the real and one-shot ones put back after.
+ */
+
+#ifndef JOURNAL_SIZE
+#define JOURNAL_SIZE 32 // power of two, 256 at most
+#endif
+
+enum journal_type
+{
+  JOURNAL_NONE = 0,
+  JOURNAL_KEY_DOWN,
+  JOURNAL_KEY_UP,
+  JOURNAL_LAYER,
+  JOURNAL_MODS,
+  JOURNAL_BOOT,
+};
+
+typedef struct
+{
+  uint16_t time;
+  uint8_t type;
+  uint8_t arg;
+  uint32_t data;
+} journal_entry_t;
+
+void journal_init(void); // call from matrix_init_user
+void journal_append(uint8_t type, uint8_t arg, uint32_t data, uint16_t time);
+
+// Call first thing in process_record_user
+void journal_key(uint16_t keycode, keyrecord_t *record);
+
+void journal_dump(void);
+bool journal_pending(void); // a dump, or a change journal_task hasn't logged
+void journal_task(void);    // call once per scan
+
+#endif
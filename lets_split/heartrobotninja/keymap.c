@@ -1,8 +1,14 @@
 #include "lets_split.h"
 #include "action_layer.h"
 #include "action_util.h"
+#include "autocorrect.h"
 #include "debug.h"
 #include "eeconfig.h"
+#include "eeprom_queue.h"
+#include "home_row.h"
+#include "journal.h"
+#include "mouse_keys.h"
+#include "steno.h"
 
 extern keymap_config_t keymap_config;
 
@@ -13,6 +19,7 @@ extern keymap_config_t keymap_config;
 #define _COLE 0
 #define _LOWER 1
 #define _RAISE 2
+#define _STENO 3
 #define _AUX 16
 
 /* Layers */
@@ -35,6 +42,12 @@ enum
   TD_USC,
 };
 
+/* Keycodes */
+enum
+{
+  JRNL = STENO_SAFE_RANGE, // types out the crash journal
+};
+
 bool time_travel = false;
 
 // Fillers to make layering more clear
@@ -93,21 +106,38 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
             KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12, KC_LBRC, KC_RBRC, KC_BSLS, KC_SCLN, KC_QUOT, KC_EQL,
             ____, ____, ____, ____, ____, ____, ____, ____, ____, KC_COMM, KC_DOT, KC_SLSH),
 
+        /* Steno, toggled from Adjust
+ * ,-----------------------------------------------------------------------------------.
+ * |   #  |   #  |   #  |   #  |   #  |   #  |   #  |   #  |   #  |   #  |   #  |   #  |
+ * |------+------+------+------+------+-------------+------+------+------+------+------|
+ * |  Fn  |   S  |   T  |   P  |   H  |   *  |   *  |   F  |   P  |   L  |   T  |   D  |
+ * |------+------+------+------+------+------|------+------+------+------+------+------|
+ * | PWR  |   S  |   K  |   W  |   R  |   *  |   *  |   R  |   B  |   G  |   S  |   Z  |
+ * |------+------+------+------+------+------+------+------+------+------+------+------|
+ * | ____ | ____ |Gemini| Bolt |   A  |   O  |   E  |   U  | ____ | ____ | ____ | ____ |
+ * `-----------------------------------------------------------------------------------'
+ */
+        [_STENO] = KEYMAP(
+            STN_N1, STN_N2, STN_N3, STN_N4, STN_N5, STN_N6, STN_N7, STN_N8, STN_N9, STN_NA, STN_NB, STN_NC,
+            STN_FN, STN_S1, STN_TL, STN_PL, STN_HL, STN_ST1, STN_ST3, STN_FR, STN_PR, STN_LR, STN_TR, STN_DR,
+            STN_PWR, STN_S2, STN_KL, STN_WL, STN_RL, STN_ST2, STN_ST4, STN_RR, STN_BR, STN_GR, STN_SR, STN_ZR,
+            ____, ____, STN_GEMINI, STN_BOLT, STN_A, STN_O, STN_E, STN_U, ____, ____, ____, ____),
+
         /* Adjust (Lower + Raise)
  * ,-----------------------------------------------------------------------------------.
- * | Reset| ____ | ____ | ____ | ____ | ____ | ____ | LOCK | ____ | ____ | ____ | VUP  |
+ * | Reset| STENO| ACL2 | ACL1 | MS U | WH U | JRNL | LOCK | ____ | ____ | ____ | VUP  |
  * |------+------+------+------+------+-------------+------+------+------+------+------|
- * | ____ | ____ |  RUN | ____ | ____ | ____ | ____ | ____ | ____ | ____ | ____ | VDWN |
+ * | ____ | ACL0 |  RUN | MS L | MS D | MS R | ____ | BTN1 | BTN2 | BTN3 | ____ | VDWN |
  * |------+------+------+------+------+------|------+------+------+------+------+------|
- * | ____ | ____ | ____ | ____ | ____ | ____ | ____ | ____ | ____ | ____ | PGUP | MUTE |
+ * | ____ | ____ | ____ | WH L | WH D | WH R | ____ | ____ | ____ | ____ | PGUP | MUTE |
  * |------+------+------+------+------+------+------+------+------+------+------+------|
  * | ____ | ____ | ____ | ____ | ____ | ____ | ____ | ____ | ____ | HOME | PGDN | END  |
  * `-----------------------------------------------------------------------------------'
  */
         [_AUX] = KEYMAP(
-            RESET, ____, ____, ____, ____, ____, ____, LGUI(KC_L), ____, ____, ____, KC_VOLU,
-            ____, ____, LGUI(KC_R), ____, ____, ____, ____, ____, ____, ____, ____, KC_VOLD,
-            ____, ____, ____, ____, ____, ____, ____, ____, ____, ____, KC_PGUP, KC_MUTE,
+            RESET, TG(_STENO), KC_ACL2, KC_ACL1, KC_MS_U, KC_WH_U, JRNL, LGUI(KC_L), ____, ____, ____, KC_VOLU,
+            ____, KC_ACL0, LGUI(KC_R), KC_MS_L, KC_MS_D, KC_MS_R, ____, KC_BTN1, KC_BTN2, KC_BTN3, ____, KC_VOLD,
+            ____, ____, ____, KC_WH_L, KC_WH_D, KC_WH_R, ____, ____, ____, ____, KC_PGUP, KC_MUTE,
             ____, ____, ____, ____, KC_TAB, KC_DEL, ____, ____, ____, KC_HOME, KC_PGDOWN, KC_END)
 
 };
@@ -122,18 +152,59 @@ qk_tap_dance_action_t tap_dance_actions[] = {
 
 void persistent_default_layer_set(uint16_t default_layer)
 {
-  eeconfig_update_default_layer(default_layer);
+  eeq_update_byte(EECONFIG_DEFAULT_LAYER, default_layer);
   default_layer_set(default_layer);
 };
 
-void matrix_scan_user(void){};
+void matrix_scan_user(void)
+{
+  eeq_task();
+  home_row_task();
+  mouse_keys_task();
+  steno_task();
+  journal_task();
+};
+
+void matrix_init_user(void)
+{
+  journal_init();
+};
 
-void matrix_init_user(void){};
+bool home_row_tap_user(uint8_t keycode)
+{
+  return autocorrect_key(keycode);
+}
 
 bool process_record_user(uint16_t keycode, keyrecord_t *record)
 {
+  journal_key(keycode, record);
+  if (!process_home_row(keycode, record))
+  {
+    return false;
+  }
+  if (!process_mouse_keys(keycode, record))
+  {
+    return false;
+  }
+  if (!process_steno_keys(keycode, record))
+  {
+    return false;
+  }
+  if (record->event.pressed && !autocorrect_key(keycode))
+  {
+    return false;
+  }
+
   switch (keycode)
   {
+  case RESET:
+    if (record->event.pressed)
+    {
+      // Don't jump to the bootloader with writes still queued
+      eeq_flush();
+    }
+    return true;
+    break;
   case COLE:
     if (record->event.pressed)
     {
@@ -167,6 +238,13 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record)
     }
     return false;
     break;
+  case JRNL:
+    if (record->event.pressed)
+    {
+      journal_dump();
+    }
+    return false;
+    break;
   case AUX:
     if (record->event.pressed)
     {
@@ -0,0 +1,181 @@
+/* Lets Split matrix, both halves merged in the order they were pressed
+ *
+ * Takes the place of keyboards/lets_split/matrix.c: the keyboard's rules.mk
+ * already builds a matrix.c with CUSTOM_MATRIX = yes, and the keymap folder
+ * comes first on the VPATH. This half's rows are read and debounced as
+ * there, and the slave sends its rows through the keyboard's serial.c as
+ * before, so both halves run the same firmware. What changes is the master:
+ * keyboard_task gets the two halves through split_link.c instead of as they
+ * arrive. Serial only.
+ */
+
+#include <avr/io.h>
+#include <string.h>
+#include <util/delay.h>
+#include "print.h"
+#include "serial.h"
+#include "split_link.h"
+#include "split_util.h"
+
+#ifdef USE_I2C
+#error "matrix.c here only speaks serial, see config.h"
+#endif
+
+#ifndef DEBOUNCE
+#define DEBOUNCE 5
+#endif
+
+// Failed transfers in a row before the other half's keys are let go
+#define ERROR_DISCONNECT_COUNT 5
+
+static const uint8_t row_pins[ROWS_PER_HAND] = MATRIX_ROW_PINS;
+static const uint8_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static matrix_row_t matrix[MATRIX_ROWS]; // as keyboard_task sees it
+static matrix_row_t bouncing[ROWS_PER_HAND];
+static matrix_row_t local[ROWS_PER_HAND];  // this half, debounced
+static matrix_row_t remote[ROWS_PER_HAND]; // the other half, as last sent
+static uint8_t debouncing;
+static uint8_t error_count;
+
+/* Pins are stored as port << 4 | bit: _SFR_IO8 of the port is PINx, +1 DDRx
+ * and +2 PORTx
+ */
+static void init_cols(void)
+{
+  for (uint8_t x = 0; x < MATRIX_COLS; x++)
+  {
+    // input with pull-up
+    _SFR_IO8((col_pins[x] >> 4) + 1) &= ~_BV(col_pins[x] & 0xF);
+    _SFR_IO8((col_pins[x] >> 4) + 2) |= _BV(col_pins[x] & 0xF);
+  }
+}
+
+static matrix_row_t read_cols(void)
+{
+  matrix_row_t cols = 0;
+  for (uint8_t x = 0; x < MATRIX_COLS; x++)
+  {
+    if (!(_SFR_IO8(col_pins[x] >> 4) & _BV(col_pins[x] & 0xF)))
+    {
+      cols |= (matrix_row_t)1 << x;
+    }
+  }
+  return cols;
+}
+
+static void unselect_rows(void)
+{
+  for (uint8_t x = 0; x < ROWS_PER_HAND; x++)
+  {
+    // hi-Z with pull-up
+    _SFR_IO8((row_pins[x] >> 4) + 1) &= ~_BV(row_pins[x] & 0xF);
+    _SFR_IO8((row_pins[x] >> 4) + 2) |= _BV(row_pins[x] & 0xF);
+  }
+}
+
+static void select_row(uint8_t row)
+{
+  // output low
+  _SFR_IO8((row_pins[row] >> 4) + 1) |= _BV(row_pins[row] & 0xF);
+  _SFR_IO8((row_pins[row] >> 4) + 2) &= ~_BV(row_pins[row] & 0xF);
+}
+
+// Reads this half into local once its rows have held still DEBOUNCE scans
+static void read_half(void)
+{
+  for (uint8_t i = 0; i < ROWS_PER_HAND; i++)
+  {
+    select_row(i);
+    _delay_us(30); // let the column lines settle
+    matrix_row_t cols = read_cols();
+    if (bouncing[i] != cols)
+    {
+      bouncing[i] = cols;
+      debouncing = DEBOUNCE;
+    }
+    unselect_rows();
+  }
+  if (debouncing && !--debouncing)
+  {
+    memcpy(local, bouncing, sizeof(local));
+  }
+}
+
+void matrix_init(void)
+{
+  unselect_rows();
+  init_cols();
+  split_link_init(isLeftHand, SPLIT_LINK_SCANS);
+  matrix_init_quantum();
+}
+
+uint8_t matrix_scan(void)
+{
+  read_half();
+  if (serial_update_buffers())
+  {
+    // Keep the other half's keys through a glitch, let them go if it's gone
+    if (error_count < ERROR_DISCONNECT_COUNT)
+    {
+      error_count++;
+    }
+    else
+    {
+      memset(remote, 0, sizeof(remote));
+    }
+  }
+  else
+  {
+    error_count = 0;
+    for (uint8_t i = 0; i < ROWS_PER_HAND; i++)
+    {
+      remote[i] = serial_slave_buffer[i];
+    }
+  }
+  split_link_scan(local, remote, matrix);
+  matrix_scan_quantum();
+  return 1;
+}
+
+// The slave's loop, from split_util.c: the master reads its rows when it likes
+void matrix_slave_scan(void)
+{
+  read_half();
+  for (uint8_t i = 0; i < ROWS_PER_HAND; i++)
+  {
+    serial_slave_buffer[i] = local[i];
+  }
+}
+
+uint8_t matrix_rows(void)
+{
+  return MATRIX_ROWS;
+}
+
+uint8_t matrix_cols(void)
+{
+  return MATRIX_COLS;
+}
+
+bool matrix_is_on(uint8_t row, uint8_t col)
+{
+  return matrix[row] & ((matrix_row_t)1 << col);
+}
+
+matrix_row_t matrix_get_row(uint8_t row)
+{
+  return matrix[row];
+}
+
+void matrix_print(void)
+{
+  print("\nr/c 012345\n");
+  for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+  {
+    phex(row);
+    print(": ");
+    pbin_reverse(matrix_get_row(row));
+    print("\n");
+  }
+}
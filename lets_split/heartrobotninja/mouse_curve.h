@@ -0,0 +1,23 @@
+// Generated by sim/build/mouse_curve_gen, do not edit
+// 100 px/s rising to 1500 px/s over 1000ms, squared; 1/16 px per 10ms report
+
+#ifndef MOUSE_CURVE_H
+#define MOUSE_CURVE_H
+
+#define MOUSE_CURVE_INTERVAL 10
+#define MOUSE_CURVE_START 100
+#define MOUSE_CURVE_MAX 1500
+#define MOUSE_CURVE_RAMP 1000
+#define MOUSE_CURVE_STEPS 101
+
+static const uint8_t PROGMEM mouse_curve[MOUSE_CURVE_STEPS] = {
+        16, 16, 16, 16, 17, 17, 17, 17, 17, 18, 19, 19, 19, 20, 21, 22,
+        22, 23, 23, 25, 25, 27, 27, 28, 30, 30, 32, 33, 34, 36, 36, 39,
+        39, 41, 43, 44, 46, 48, 49, 51, 53, 54, 57, 58, 60, 63, 64, 67,
+        68, 71, 73, 76, 78, 80, 82, 85, 88, 90, 92, 96, 98, 101, 103, 106,
+        110, 112, 115, 118, 121, 124, 127, 131, 134, 137, 140, 144, 147, 150, 154, 158,
+        161, 165, 168, 173, 175, 180, 184, 187, 192, 195, 200, 203, 208, 212, 216, 220,
+        225, 229, 233, 238, 240,
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef MOUSE_KEYS_H
+#define MOUSE_KEYS_H
+
+#include "quantum.h"
+
+/* Mouse keys
+ *
+ * Takes over KC_MS_*, KC_BTN*, KC_WH_* and KC_ACL* with MOUSEKEY_ENABLE
+ * left off; MOUSE_ENABLE in rules.mk still gives the board its mouse
+ * endpoint. While a direction is held, a report goes out every
+ * MOUSE_CURVE_INTERVAL ms, the mouse endpoint's polling interval.
+ *
+ * Speed comes from mouse_curve.h, one entry per report in 1/16 px, and is
+ * added to a fraction that is shifted down to whole pixels, so slow speeds
+ * still move evenly and nothing divides per report. Diagonals are scaled
+ * by 181/256 (1/sqrt 2). The wheel runs off the same curve with a detent
+ * every 16 << MOUSE_KEYS_WHEEL_SHIFT units. KC_ACL0 and KC_ACL1 held give
+ * quarter and half speed, KC_ACL2 full speed at once. Up to
+ * MOUSE_KEYS_HELD mouse keys can be down at a time; each is let go when
+ * the position that pressed it is released, whatever layer is up by then.
+ *
+ * Budget: 1KB of flash with the curve, 24 bytes of RAM.
+ */
+
+#ifndef MOUSE_KEYS_WHEEL_SHIFT
+#define MOUSE_KEYS_WHEEL_SHIFT 5
+#endif
+
+#ifndef MOUSE_KEYS_HELD
+#define MOUSE_KEYS_HELD 4
+#endif
+
+bool process_mouse_keys(uint16_t keycode, keyrecord_t *record);
+// Milliseconds until the moving pointer or wheel reports, 0xFFFF when neither is
+uint16_t mouse_keys_due_in(void);
+void mouse_keys_task(void); // call once per scan
+
+#endif
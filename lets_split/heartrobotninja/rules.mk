@@ -4,11 +4,13 @@
 #
 BOOTMAGIC_ENABLE = no       # Virtual DIP switch configuration(+1000)
 MOUSEKEY_ENABLE = no       # Mouse keys(+4700)
+MOUSE_ENABLE = yes          # Mouse endpoint, for mouse_keys.c
 EXTRAKEY_ENABLE = yes       # Audio control and System control(+450)
 CONSOLE_ENABLE = no         # Console for debug(+400)
+VIRTSER_ENABLE = yes        # Virtual serial port, for steno.c
 COMMAND_ENABLE = no        # Commands for debug and configuration
 TAP_DANCE_ENABLE = yes
-NKRO_ENABLE = yes            # Nkey Rollover - if this doesn't work, see here: https://github.com/tmk/tmk_keyboard/wiki/FAQ#nkro-doesnt-work
+NKRO_ENABLE = no            # Nkey Rollover - its endpoint goes to VIRTSER_ENABLE
 BACKLIGHT_ENABLE = no      # Enable keyboard backlight functionality
 MIDI_ENABLE = no            # MIDI controls
 AUDIO_ENABLE = no           # Audio output on port C6
@@ -20,6 +22,18 @@ ONEHAND_ENABLE = no        # Enable one-hand typing
 # Do not enable SLEEP_LED_ENABLE. it uses the same timer as BACKLIGHT_ENABLE
 SLEEP_LED_ENABLE = no    # Breathing sleep LED during USB suspend
 
+SRC += eeprom_queue.c
+SRC += home_row.c
+SRC += autocorrect.c
+SRC += mouse_keys.c
+SRC += steno.c
+SRC += journal.c
+SRC += split_link.c
+
+# The keyboard's rules.mk builds matrix.c; the one in this folder, which
+# merges the halves through split_link.c, comes first on the VPATH
+CUSTOM_MATRIX = yes
+
 ifndef QUANTUM_DIR
 	include ../../../../Makefile
 endif
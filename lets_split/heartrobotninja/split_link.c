@@ -0,0 +1,122 @@
+#include "split_link.h"
+
+#define LINK_QUEUE 8 // power of two
+
+typedef struct
+{
+  uint8_t stamp; // master scan it happened on
+  keypos_t key;
+  bool pressed;
+} link_event_t;
+
+typedef struct
+{
+  link_event_t q[LINK_QUEUE];
+  uint8_t head;
+  uint8_t count;
+} link_queue_t;
+
+static bool master_left;
+static uint8_t link_scans;
+static uint8_t scans;
+static matrix_row_t local_prev[ROWS_PER_HAND];
+static matrix_row_t remote_prev[ROWS_PER_HAND];
+static link_queue_t local_events;
+static link_queue_t remote_events;
+
+void split_link_init(bool left_is_master, uint8_t latency)
+{
+  master_left = left_is_master;
+  link_scans = latency;
+}
+
+static void link_apply(link_queue_t *q, matrix_row_t *matrix)
+{
+  link_event_t *e = &q->q[q->head];
+  if (e->pressed)
+  {
+    matrix[e->key.row] |= (matrix_row_t)1 << e->key.col;
+  }
+  else
+  {
+    matrix[e->key.row] &= ~((matrix_row_t)1 << e->key.col);
+  }
+  q->head = (q->head + 1) % LINK_QUEUE;
+  q->count--;
+}
+
+// Queues what changed in one half's rows since its last scan
+static void link_diff(link_queue_t *q, const matrix_row_t *rows, matrix_row_t *prev, uint8_t offset,
+                      uint8_t stamp, matrix_row_t *matrix)
+{
+  for (uint8_t r = 0; r < ROWS_PER_HAND; r++)
+  {
+    matrix_row_t change = rows[r] ^ prev[r];
+    prev[r] = rows[r];
+    for (uint8_t c = 0; change; c++, change >>= 1)
+    {
+      if (!(change & 1))
+      {
+        continue;
+      }
+      if (q->count == LINK_QUEUE)
+      {
+        // A whole hand at once: hand on the oldest now rather than lose it
+        link_apply(q, matrix);
+      }
+      q->q[(q->head + q->count++) % LINK_QUEUE] = (link_event_t){
+          .stamp = stamp, .key = {.row = offset + r, .col = c}, .pressed = (rows[r] >> c) & 1};
+    }
+  }
+}
+
+// Earliest transition whose scan both halves have reported, NULL if none
+static link_queue_t *link_next(void)
+{
+  uint8_t complete = scans - link_scans;
+  link_queue_t *next = NULL;
+  link_queue_t *queues[] = {&local_events, &remote_events};
+
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    link_queue_t *q = queues[i];
+    if (!q->count || (int8_t)(q->q[q->head].stamp - complete) > 0)
+    {
+      continue;
+    }
+    if (!next)
+    {
+      next = q;
+      continue;
+    }
+    link_event_t *a = &q->q[q->head], *b = &next->q[next->head];
+    int8_t order = a->stamp - b->stamp;
+    if (order < 0 || (!order && a->key.row < b->key.row))
+    {
+      next = q;
+    }
+  }
+  return next;
+}
+
+void split_link_scan(const matrix_row_t *local, const matrix_row_t *remote, matrix_row_t *matrix)
+{
+  uint8_t local_offset = master_left ? 0 : ROWS_PER_HAND;
+
+  scans++;
+  link_diff(&local_events, local, local_prev, local_offset, scans, matrix);
+  // What arrives now left the slave link_scans ago
+  link_diff(&remote_events, remote, remote_prev, ROWS_PER_HAND - local_offset, scans - link_scans,
+            matrix);
+
+  link_queue_t *q = link_next();
+  if (q)
+  {
+    link_apply(q, matrix);
+  }
+}
+
+bool split_link_pending(void)
+{
+  return local_events.count || remote_events.count;
+}
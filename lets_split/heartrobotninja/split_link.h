@@ -0,0 +1,42 @@
+#ifndef SPLIT_LINK_H
+#define SPLIT_LINK_H
+
+#include "quantum.h"
+
+/* Split link ordering
+ *
+ * The master reads the slave half's rows over serial, SPLIT_LINK_SCANS
+ * scans after the slave scanned them, while its own rows are read as they
+ * are. Handed straight to keyboard_task, a slave key can be processed after
+ * a master key pressed after it, and a fast cross-hand roll comes out of
+ * order.
+ *
+ * matrix.c passes both halves' rows through split_link_scan() instead. Each
+ * transition is stamped with the master's scan counter: its own as it reads
+ * them, the slave's as they arrive less the link's latency, since the
+ * keyboard's serial.c only carries the rows. Master transitions are kept
+ * back until the slave's for the same scan are in, and the matrix handed on
+ * takes the earliest of the two streams one transition a scan, the lower row
+ * on a tie, the way keyboard_task takes them.
+ *
+ * Costs the link latency on master keys. Budget: 64 bytes of RAM for the
+ * queues.
+ */
+
+#ifndef SPLIT_LINK_SCANS
+#define SPLIT_LINK_SCANS 1
+#endif
+
+#ifndef ROWS_PER_HAND
+#define ROWS_PER_HAND (MATRIX_ROWS / 2)
+#endif
+
+void split_link_init(bool left_is_master, uint8_t latency);
+/* One master scan: local is this half's rows as read now, remote the other
+ * half's as the link last brought them. Updates matrix, all MATRIX_ROWS of
+ * it, with at most one transition.
+ */
+void split_link_scan(const matrix_row_t *local, const matrix_row_t *remote, matrix_row_t *matrix);
+bool split_link_pending(void); // transitions still queued
+
+#endif
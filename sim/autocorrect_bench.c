@@ -0,0 +1,312 @@
+/* Per-keystroke cost of the keymaps' autocorrect
+ *
+ *   autocorrect_bench [-k keys] [-s seed] [-d dict.txt] [sizes ...]
+ *
+ * Builds a trie for each dictionary size (default 100 250 500 1000 2000)
+ * from generated words and adjacent-letter swaps, or uses -d, then types a
+ * stream of those words with typos mixed in through autocorrect.c itself.
+ * Reports trie size, trie bytes read per key (what the AVR pays for in LPM
+ * cycles), host time per key and whether the text came out corrected.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "autocorrect_trie.h"
+#include "qmk_sim.h"
+
+/* autocorrect.c, built against a trie loaded at run time. Its includes are
+ * already satisfied, so AUTOCORRECT_DATA just points back at qmk_sim.h.
+ */
+
+static uint8_t bench_trie[0x10000];
+static unsigned long trie_reads;
+bool leading;
+
+#undef pgm_read_byte
+#undef pgm_read_word
+#define pgm_read_byte(p) (trie_reads++, *(const uint8_t *)(p))
+#define pgm_read_word(p) (trie_reads += 2, *(const uint16_t *)(p))
+
+#define autocorrect_data bench_trie
+#define AUTOCORRECT_MAX_LENGTH AC_MAX_WORD
+#define AUTOCORRECT_DATA "qmk_sim.h"
+#include "../lets_split/heartrobotninja/autocorrect.c"
+
+/* What the host would see */
+
+static char screen[1 << 20];
+static size_t screen_len;
+
+static char code_char(uint8_t code)
+{
+  if (code >= KC_A && code <= KC_Z)
+  {
+    return 'a' + code - KC_A;
+  }
+  return code == KC_QUOT ? '\'' : code == KC_SPC ? ' ' : '?';
+}
+
+void register_code(uint8_t code)
+{
+  if (code == KC_BSPC)
+  {
+    if (screen_len)
+    {
+      screen_len--;
+    }
+  }
+  else if (screen_len < sizeof(screen))
+  {
+    screen[screen_len++] = code_char(code);
+  }
+}
+
+void unregister_code(uint8_t code)
+{
+}
+
+uint8_t get_mods(void)
+{
+  return 0;
+}
+
+uint8_t get_oneshot_mods(void)
+{
+  return 0;
+}
+
+/* Dictionaries */
+
+static uint64_t rng;
+
+static uint32_t next_rand(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng >> 16;
+}
+
+static void random_word(char *w)
+{
+  // Roughly English letter frequencies
+  static const char letters[] = "eeeeeeeeeeeettttttttaaaaaaaaoooooooiiiiiiinnnnnnnsssssshhhhhhrrrrrr"
+                                "ddddllllcccuuummwwffggyyppbbvkjxqz";
+  int len = 5 + next_rand() % 6;
+  for (int i = 0; i < len; i++)
+  {
+    w[i] = letters[next_rand() % (sizeof(letters) - 1)];
+  }
+  w[len] = 0;
+}
+
+// True when typo or word is already in use, either way round
+static bool clashes(const ac_entry_t *entries, int n, const char *typo, const char *word)
+{
+  for (int k = 0; k < n; k++)
+  {
+    const char *t = entries[k].typo + 1;
+    size_t len = strcspn(t, ":");
+    if ((strlen(word) == len && !strncmp(t, word, len)) ||
+        (strlen(typo) == len && !strncmp(t, typo, len)) || !strcmp(entries[k].correction, typo))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static int generate(ac_entry_t *entries, int count)
+{
+  for (int n = 0; n < count; n++)
+  {
+    char word[AC_MAX_WORD], typo[AC_MAX_WORD];
+    size_t len;
+    int i;
+    do
+    {
+      random_word(word);
+      len = strlen(word);
+      i = 1 + next_rand() % (len - 2);
+      strcpy(typo, word);
+      typo[i] = word[i + 1];
+      typo[i + 1] = word[i];
+    } while (word[i] == word[i + 1] || clashes(entries, n, typo, word));
+    snprintf(entries[n].typo, AC_MAX_WORD, ":%s%s", typo, next_rand() % 2 ? ":" : "");
+    strcpy(entries[n].correction, word);
+  }
+  return count;
+}
+
+/* Typing */
+
+static void type_word(const char *w, size_t *keys)
+{
+  for (; *w; w++)
+  {
+    uint8_t code = *w == '\'' ? KC_QUOT : KC_A + (*w - 'a');
+    if (autocorrect_key(code))
+    {
+      register_code(code);
+    }
+    (*keys)++;
+  }
+  if (autocorrect_key(KC_SPC))
+  {
+    register_code(KC_SPC);
+  }
+  (*keys)++;
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int run(const ac_entry_t *entries, int count, size_t target_keys)
+{
+  ac_trie_info_t info;
+  if (ac_build(entries, count, bench_trie, sizeof(bench_trie), &info, NULL) < 0)
+  {
+    return 1;
+  }
+
+  // Only entries that made it into the trie can be expected to fire
+  ac_entry_t *live = malloc(count * sizeof(ac_entry_t));
+  int nlive = 0;
+  for (int i = 0; i < count; i++)
+  {
+    bool shadowed = false;
+    for (int j = 0; j < count && !shadowed; j++)
+    {
+      size_t a = strlen(entries[i].typo), b = strlen(entries[j].typo);
+      shadowed = j != i && b <= a && !strcmp(entries[i].typo + a - b, entries[j].typo) &&
+                 (b < a || j < i);
+    }
+    if (!shadowed)
+    {
+      live[nlive++] = entries[i];
+    }
+  }
+
+  static char expected[1 << 20];
+  size_t expected_len = 0, keys = 0;
+  unsigned long worst = 0;
+  double elapsed = 0;
+
+  screen_len = 0;
+  reset();
+  trie_reads = 0;
+  while (keys < target_keys && expected_len + 2 * AC_MAX_WORD < sizeof(expected))
+  {
+    const ac_entry_t *e = &live[next_rand() % nlive];
+    bool typo = next_rand() % 20 == 0;
+    char word[AC_MAX_WORD];
+    if (typo)
+    {
+      // Strip the ':' anchors to get what the fingers type
+      const char *t = e->typo[0] == ':' ? e->typo + 1 : e->typo;
+      snprintf(word, sizeof(word), "%.*s", (int)(strlen(t) - (t[strlen(t) - 1] == ':')), t);
+    }
+    else
+    {
+      strcpy(word, e->correction);
+    }
+
+    unsigned long before = trie_reads;
+    size_t keys_before = keys;
+    double t0 = now();
+    type_word(word, &keys);
+    elapsed += now() - t0;
+    unsigned long per_key = (trie_reads - before) / (keys - keys_before);
+    if (per_key > worst)
+    {
+      worst = per_key;
+    }
+
+    expected_len += sprintf(expected + expected_len, "%s ", e->correction);
+  }
+
+  size_t wrong = 0;
+  for (size_t i = 0; i < expected_len && i < screen_len; i++)
+  {
+    wrong += expected[i] != screen[i];
+  }
+  wrong += screen_len > expected_len ? screen_len - expected_len : expected_len - screen_len;
+
+  printf("%6d %6d %7zu %5d %8.2f %8lu %9.0f %7.1f  %s\n", count, info.entries, info.size,
+         info.max_length, (double)trie_reads / keys, worst, 8.0 * trie_reads / keys + 60,
+         elapsed / keys * 1e9, wrong ? "TEXT DIFFERS" : "ok");
+  free(live);
+  return wrong != 0;
+}
+
+int main(int argc, char **argv)
+{
+  size_t keys = 1000000;
+  const char *dict = NULL;
+  int opt;
+
+  rng = 0x9E3779B97F4A7C15ULL;
+  while ((opt = getopt(argc, argv, "k:s:d:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'k':
+      keys = strtoul(optarg, NULL, 0);
+      break;
+    case 's':
+      rng ^= strtoull(optarg, NULL, 0) * 0x2545F4914F6CDD1DULL;
+      break;
+    case 'd':
+      dict = optarg;
+      break;
+    default:
+      fprintf(stderr, "usage: autocorrect_bench [-k keys] [-s seed] [-d dict.txt] [sizes ...]\n");
+      return 2;
+    }
+  }
+
+  printf("#  entries: asked for / in trie; reads: trie bytes read per key, mean and worst\n"
+         "#  word; avr: estimated cycles per key at ~8 per trie byte plus fixed overhead\n");
+  printf("%6s %6s %7s %5s %8s %8s %9s %7s\n", "asked", "trie", "bytes", "depth", "reads",
+         "worst", "avr cyc", "host ns");
+
+  int failures = 0;
+  if (dict)
+  {
+    FILE *in = fopen(dict, "r");
+    if (!in)
+    {
+      perror(dict);
+      return 2;
+    }
+    ac_entry_t *entries;
+    int count = ac_parse(in, dict, &entries);
+    fclose(in);
+    if (count <= 0)
+    {
+      return 2;
+    }
+    failures += run(entries, count, keys);
+    free(entries);
+    return failures ? 1 : 0;
+  }
+
+  static const int default_sizes[] = {100, 250, 500, 1000, 2000};
+  int nsizes = argc - optind;
+  for (int i = 0; i < (nsizes ? nsizes : 5); i++)
+  {
+    int n = nsizes ? atoi(argv[optind + i]) : default_sizes[i];
+    ac_entry_t *entries = malloc(n * sizeof(ac_entry_t));
+    generate(entries, n);
+    failures += run(entries, n, keys);
+    free(entries);
+  }
+  return failures ? 1 : 0;
+}
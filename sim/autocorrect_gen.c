@@ -0,0 +1,63 @@
+/* Compiles an autocorrect dictionary into the keymap's trie header
+ *
+ *   autocorrect_gen autocorrect_dict.txt autocorrect_data.h
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "autocorrect_trie.h"
+
+int main(int argc, char **argv)
+{
+  if (argc != 3)
+  {
+    fprintf(stderr, "usage: autocorrect_gen dict.txt out.h\n");
+    return 2;
+  }
+
+  FILE *in = fopen(argv[1], "r");
+  if (!in)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  ac_entry_t *entries;
+  int count = ac_parse(in, argv[1], &entries);
+  fclose(in);
+  if (count < 0)
+  {
+    return 1;
+  }
+
+  static uint8_t trie[0x10000];
+  ac_trie_info_t info;
+  if (ac_build(entries, count, trie, sizeof(trie), &info, stderr) < 0)
+  {
+    return 1;
+  }
+
+  FILE *out = fopen(argv[2], "w");
+  if (!out)
+  {
+    perror(argv[2]);
+    return 1;
+  }
+  fprintf(out, "// Generated by sim/build/autocorrect_gen from autocorrect_dict.txt, do not edit\n"
+               "// %d entries, %zu bytes\n\n"
+               "#ifndef AUTOCORRECT_DATA_H\n"
+               "#define AUTOCORRECT_DATA_H\n\n"
+               "#define AUTOCORRECT_MAX_LENGTH %d\n\n"
+               "static const uint8_t PROGMEM autocorrect_data[%zu] = {",
+          info.entries, info.size, info.max_length, info.size);
+  for (size_t i = 0; i < info.size; i++)
+  {
+    fprintf(out, "%s0x%02X,", i % 12 ? " " : "\n        ", trie[i]);
+  }
+  fprintf(out, "\n};\n\n#endif\n");
+  fclose(out);
+
+  printf("%s: %d entries, %d dropped, %zu bytes, longest typo %d\n", argv[2], info.entries,
+         info.dropped, info.size, info.max_length);
+  free(entries);
+  return 0;
+}
@@ -0,0 +1,270 @@
+#include <stdlib.h>
+#include <string.h>
+#include "autocorrect_trie.h"
+#include "sim.h"
+
+#define CODES 64
+
+typedef struct node
+{
+  struct node *child[CODES];
+  const ac_entry_t *leaf;
+  uint8_t nchildren;
+} node_t;
+
+static uint8_t char_code(char c)
+{
+  if (c >= 'a' && c <= 'z')
+  {
+    return KC_A + (c - 'a');
+  }
+  if (c == '\'')
+  {
+    return KC_QUOT;
+  }
+  if (c == ':')
+  {
+    return KC_SPC;
+  }
+  return 0;
+}
+
+static bool valid_word(const char *s, bool allow_boundary)
+{
+  if (!*s)
+  {
+    return false;
+  }
+  for (const char *p = s; *p; p++)
+  {
+    if (*p == ':' && !(allow_boundary && (p == s || !p[1])))
+    {
+      return false;
+    }
+    if (!char_code(*p))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+int ac_parse(FILE *in, const char *name, ac_entry_t **entries)
+{
+  char line[256];
+  int count = 0, cap = 0, lineno = 0;
+
+  *entries = NULL;
+  while (fgets(line, sizeof(line), in))
+  {
+    lineno++;
+    char *hash = strchr(line, '#');
+    if (hash)
+    {
+      *hash = 0;
+    }
+    char typo[AC_MAX_WORD], correction[AC_MAX_WORD], arrow[4];
+    int n = sscanf(line, "%31s %3s %31s", typo, arrow, correction);
+    if (n <= 0)
+    {
+      continue;
+    }
+    if (n != 3 || strcmp(arrow, "->") || !valid_word(typo, true) || !valid_word(correction, false))
+    {
+      fprintf(stderr, "%s:%d: expected \"typo -> correction\"\n", name, lineno);
+      return -1;
+    }
+    if (count == cap)
+    {
+      cap = cap ? cap * 2 : 256;
+      *entries = realloc(*entries, cap * sizeof(ac_entry_t));
+    }
+    strcpy((*entries)[count].typo, typo);
+    strcpy((*entries)[count].correction, correction);
+    count++;
+  }
+  return count;
+}
+
+static int by_length(const void *a, const void *b)
+{
+  return (int)strlen(((const ac_entry_t *)a)->typo) - (int)strlen(((const ac_entry_t *)b)->typo);
+}
+
+static void free_node(node_t *n)
+{
+  for (int i = 0; i < CODES; i++)
+  {
+    if (n->child[i])
+    {
+      free_node(n->child[i]);
+    }
+  }
+  free(n);
+}
+
+typedef struct
+{
+  uint8_t *out;
+  size_t cap;
+  size_t size;
+  bool overflow;
+} writer_t;
+
+static void put(writer_t *w, uint8_t b)
+{
+  if (w->size < w->cap)
+  {
+    w->out[w->size] = b;
+  }
+  else
+  {
+    w->overflow = true;
+  }
+  w->size++;
+}
+
+static void put_leaf(writer_t *w, const ac_entry_t *e)
+{
+  const char *typo = e->typo[0] == ':' ? e->typo + 1 : e->typo;
+  size_t typo_len = strlen(typo);
+  bool pass = typo[typo_len - 1] == ':';
+  if (pass)
+  {
+    typo_len--;
+  }
+
+  // Letters already on screen: the whole typo when the boundary key fired
+  // it, all but the last letter otherwise
+  size_t typed = pass ? typo_len : typo_len - 1;
+  size_t keep = 0;
+  while (keep < typed && typo[keep] == e->correction[keep])
+  {
+    keep++;
+  }
+
+  put(w, 0x80 | (pass ? 0x40 : 0) | (typed - keep));
+  for (const char *c = e->correction + keep; *c; c++)
+  {
+    put(w, char_code(*c));
+  }
+  put(w, 0);
+}
+
+static size_t put_node(writer_t *w, const node_t *n)
+{
+  size_t at = w->size;
+
+  if (n->leaf)
+  {
+    put_leaf(w, n->leaf);
+    return at;
+  }
+  if (n->nchildren == 1)
+  {
+    // Collapse the run of single-child nodes into a chain
+    while (!n->leaf && n->nchildren == 1)
+    {
+      for (int i = 0; i < CODES; i++)
+      {
+        if (n->child[i])
+        {
+          put(w, i);
+          n = n->child[i];
+          break;
+        }
+      }
+    }
+    put(w, 0);
+    put_node(w, n);
+    return at;
+  }
+
+  put(w, 0x40);
+  size_t table = w->size;
+  for (int i = 0; i < n->nchildren; i++)
+  {
+    put(w, 0);
+    put(w, 0);
+    put(w, 0);
+  }
+  put(w, 0);
+  size_t entry = table;
+  for (int i = 0; i < CODES; i++)
+  {
+    if (!n->child[i])
+    {
+      continue;
+    }
+    size_t child = put_node(w, n->child[i]);
+    if (entry + 2 < w->cap)
+    {
+      w->out[entry] = i;
+      w->out[entry + 1] = child & 0xFF;
+      w->out[entry + 2] = child >> 8;
+    }
+    entry += 3;
+  }
+  return at;
+}
+
+int ac_build(const ac_entry_t *entries, int count, uint8_t *out, size_t cap,
+             ac_trie_info_t *info, FILE *warnings)
+{
+  ac_entry_t *sorted = malloc((count ? count : 1) * sizeof(ac_entry_t));
+  memcpy(sorted, entries, count * sizeof(ac_entry_t));
+  // Shortest first, so a typo that ends in another typo is the one dropped:
+  // the shorter one always fires first
+  qsort(sorted, count, sizeof(ac_entry_t), by_length);
+
+  node_t *root = calloc(1, sizeof(node_t));
+  memset(info, 0, sizeof(*info));
+
+  for (int e = 0; e < count; e++)
+  {
+    const char *typo = sorted[e].typo;
+    size_t len = strlen(typo);
+    node_t *n = root;
+    bool shadowed = false;
+
+    for (size_t i = len; i-- > 0 && !shadowed;)
+    {
+      uint8_t c = char_code(typo[i]);
+      if (!n->child[c])
+      {
+        n->child[c] = calloc(1, sizeof(node_t));
+        n->nchildren++;
+      }
+      n = n->child[c];
+      shadowed = n->leaf != NULL;
+    }
+    if (shadowed || n->nchildren)
+    {
+      if (warnings)
+      {
+        fprintf(warnings, "dropping \"%s\": it ends in a shorter typo\n", typo);
+      }
+      info->dropped++;
+      continue;
+    }
+    n->leaf = &sorted[e];
+    info->entries++;
+    if (len > info->max_length)
+    {
+      info->max_length = len;
+    }
+  }
+
+  writer_t w = {out, cap, 0, false};
+  put_node(&w, root);
+  info->size = w.size;
+  free_node(root);
+  free(sorted);
+
+  if (w.overflow || w.size > 0xFFFF)
+  {
+    fprintf(stderr, "trie needs %zu bytes, more than %zu\n", w.size, cap < 0xFFFF ? cap : 0xFFFF);
+    return -1;
+  }
+  return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef AUTOCORRECT_TRIE_H
+#define AUTOCORRECT_TRIE_H
+
+/* Builds the typo trie that the keymaps' autocorrect.c walks; the format is
+ * described there. Shared by autocorrect_gen and autocorrect_bench.
+ *
+ * Dictionary lines are "typo -> correction", lowercase letters and
+ * apostrophes. A ':' at either end of the typo anchors it to a word
+ * boundary; a trailing ':' makes the correction fire on the key that ends
+ * the word. '#' starts a comment.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define AC_MAX_WORD 32
+
+typedef struct
+{
+  char typo[AC_MAX_WORD];
+  char correction[AC_MAX_WORD];
+} ac_entry_t;
+
+typedef struct
+{
+  size_t size;        // bytes of trie written
+  int entries;        // entries in the trie
+  int dropped;        // entries shadowed by a shorter typo
+  uint8_t max_length; // longest typo, boundaries included
+} ac_trie_info_t;
+
+// Returns the number of entries read, -1 after printing a parse error
+int ac_parse(FILE *in, const char *name, ac_entry_t **entries);
+
+// Returns 0 on success, -1 after printing an error
+int ac_build(const ac_entry_t *entries, int count, uint8_t *out, size_t cap,
+             ac_trie_info_t *info, FILE *warnings);
+
+#endif
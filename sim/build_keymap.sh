@@ -0,0 +1,18 @@
+#!/bin/sh
+# build_keymap.sh <keymap dir> <keyboard> <output.so>
+#
+# Builds a keymap the way QMK would see it: config.h force-included, the
+# rules.mk SRC files compiled in and every "*_ENABLE = yes" turned into
+# -D*_ENABLE. Run from sim/; KEYMAP_CFLAGS and RUNTIME come from the Makefile.
+set -e
+
+dir=$1
+kb=$2
+out=$3
+
+src=$(sed -n 's/^SRC *+= *//p' "$dir/rules.mk" | tr ' ' '\n' | sed "/^$/d; s|^|$dir/|")
+defs=$(sed -n 's/^ *\([A-Z_]*_ENABLE\) *= *yes.*/-D\1/p' "$dir/rules.mk")
+keymap=$(cd "$dir" && pwd)/keymap.c
+
+exec ${CC:-cc} $KEYMAP_CFLAGS $defs -DQMK_KEYBOARD="\"$kb\"" -DQMK_KEYBOARD_H="\"$kb.h\"" -DKEYMAP_C="\"$keymap\"" \
+  -include "$dir/config.h" -o "$out" qmk/sim_keymap.c $RUNTIME $src
@@ -0,0 +1,12 @@
+#ifndef SIM_CONFIG_H
+#define SIM_CONFIG_H
+
+/* Keyboard-level config for the host sim. The keymap config.h files include
+ * "../../config.h", which resolves here through the sim include path.
+ */
+
+#define TAPPING_TERM 200
+#define TAPPING_TOGGLE 5
+#define LEADER_TIMEOUT 300
+
+#endif
@@ -0,0 +1,239 @@
+/* Rolls and chords off the keymaps' home row mods
+ *
+ *   home_row_check keymap.so
+ *
+ * After a pause, for T and N (shift on their hand), rolls onto every base
+ * layer key on the other hand that types something: home row key down,
+ * other key down, home row key up, other key up, 30ms apart, then X. Checks
+ * each types what tapping the same keys one after another does, so a tap
+ * dance or one-shot mod on the other hand can't turn the letter into a
+ * modifier. Then chords T and N with each plain key on the other hand,
+ * which must come out shifted.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "sim.h"
+
+#define STEP_SCANS 30
+#define PAUSE_SCANS 1000
+#define MAX_TEXT 64
+
+typedef struct
+{
+  report_keyboard_t prev;
+  char text[MAX_TEXT];
+  size_t len;
+} host_t;
+
+typedef struct
+{
+  uint8_t row, col;
+} pos_t;
+
+static const sim_board_t *board;
+static host_t host;
+
+// A key as typed: its character, or its usage in hex when that isn't printable
+static void key_text(char *buf, size_t len, uint8_t code, bool shifted)
+{
+  char c = sim_keycode_char(code, shifted);
+  if (c > ' ' && c <= '~')
+  {
+    snprintf(buf, len, "%c", c);
+  }
+  else
+  {
+    snprintf(buf, len, "{%02X}", code);
+  }
+}
+
+static void put(const char *s)
+{
+  size_t n = strlen(s);
+  if (host.len + n < MAX_TEXT)
+  {
+    memcpy(host.text + host.len, s, n + 1);
+    host.len += n;
+  }
+}
+
+/* What a host would type, with each key that goes down as its character and
+ * any modifier other than shift in front of it as <mods>
+ */
+static void host_report(void *ctx, const report_keyboard_t *r)
+{
+  const uint8_t shift = MOD_BIT(KC_LSFT) | MOD_BIT(KC_RSFT);
+  char buf[16];
+  for (int code = 0; code < 256; code++)
+  {
+    uint8_t bit = 1 << (code & 7);
+    if ((r->bits[code >> 3] & bit) && !(host.prev.bits[code >> 3] & bit))
+    {
+      if (r->mods & ~shift)
+      {
+        snprintf(buf, sizeof(buf), "<%02X>", r->mods & ~shift);
+        put(buf);
+      }
+      key_text(buf, sizeof(buf), code, r->mods & shift);
+      put(buf);
+    }
+  }
+  host.prev = *r;
+}
+
+static void scan(int n)
+{
+  while (n--)
+  {
+    board->scan();
+  }
+}
+
+static void settle(void)
+{
+  while (!board->idle())
+  {
+    board->scan();
+  }
+  scan(PAUSE_SCANS);
+}
+
+static void key(pos_t p, bool pressed)
+{
+  board->key(p.row, p.col, pressed);
+  scan(STEP_SCANS);
+}
+
+static bool find(uint16_t keycode, pos_t *p)
+{
+  for (uint8_t r = 0; r < board->rows; r++)
+  {
+    for (uint8_t c = 0; c < board->cols; c++)
+    {
+      if (SIM_KEYMAP_AT(board, 0, r, c) == keycode)
+      {
+        *p = (pos_t){r, c};
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static bool is_right(pos_t p)
+{
+  return board->fingers[p.row * board->cols + p.col] >= F_RT;
+}
+
+static bool is_home_row(uint16_t kc)
+{
+  return kc == KC_A || kc == KC_R || kc == KC_S || kc == KC_T || kc == KC_N || kc == KC_E ||
+         kc == KC_I || kc == KC_O;
+}
+
+// Keys that type on their own: plain, tap dance, one-shot mod and modified
+static bool types(uint16_t kc)
+{
+  return (kc >= KC_A && kc <= KC_SLASH && !is_home_row(kc)) ||
+         (kc >= QK_TAP_DANCE && kc <= QK_TAP_DANCE_MAX) ||
+         (kc >= QK_ONE_SHOT_MOD && kc <= QK_ONE_SHOT_MOD_MAX) ||
+         (kc >= QK_MODS && kc <= QK_MODS_MAX);
+}
+
+static void start(void)
+{
+  settle();
+  host.len = 0;
+  host.text[0] = 0;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 2)
+  {
+    fprintf(stderr, "usage: home_row_check keymap.so\n");
+    return 2;
+  }
+  board = sim_load(argv[1]);
+  board->set_report_hook(host_report, NULL);
+  board->init();
+
+  pos_t x;
+  if (!find(KC_X, &x))
+  {
+    fprintf(stderr, "%s: no X on the base layer\n", argv[1]);
+    return 2;
+  }
+
+  static const uint16_t home[] = {KC_T, KC_N};
+  int checks = 0, failures = 0;
+  for (size_t h = 0; h < sizeof(home) / sizeof(home[0]); h++)
+  {
+    pos_t hp;
+    if (!find(home[h], &hp))
+    {
+      continue;
+    }
+    for (uint8_t r = 0; r < board->rows; r++)
+    {
+      for (uint8_t c = 0; c < board->cols; c++)
+      {
+        pos_t op = {r, c};
+        uint16_t kc = SIM_KEYMAP_AT(board, 0, r, c);
+        if (!board->fingers[r * board->cols + c] || is_right(op) == is_right(hp) || !types(kc))
+        {
+          continue;
+        }
+        char buf[32], expect[MAX_TEXT], got[MAX_TEXT];
+        const char *name = sim_keycode_name(kc, buf, sizeof(buf));
+
+        start();
+        key(hp, true);
+        key(hp, false);
+        key(op, true);
+        key(op, false);
+        key(x, true);
+        key(x, false);
+        settle();
+        strcpy(expect, host.text);
+
+        start();
+        key(hp, true);
+        key(op, true);
+        key(hp, false);
+        key(op, false);
+        key(x, true);
+        key(x, false);
+        settle();
+        strcpy(got, host.text);
+
+        bool ok = !strcmp(got, expect);
+        printf("roll  %c %-16s %-12s %-12s%s\n", sim_keycode_char(home[h], false), name, expect,
+               got, ok ? "" : "  WRONG");
+        checks++;
+        failures += !ok;
+
+        if (kc > KC_SLASH)
+        {
+          continue;
+        }
+        start();
+        key(hp, true);
+        key(op, true);
+        key(op, false);
+        key(hp, false);
+        settle();
+        key_text(expect, sizeof(expect), kc, true);
+
+        ok = !strcmp(host.text, expect);
+        printf("chord %c %-16s %-12s %-12s%s\n", sim_keycode_char(home[h], false), name, expect,
+               host.text, ok ? "" : "  WRONG");
+        checks++;
+        failures += !ok;
+      }
+    }
+  }
+  printf("# %d checks, %d wrong\n", checks, failures);
+  return failures ? 1 : 0;
+}
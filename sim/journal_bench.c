@@ -0,0 +1,258 @@
+/* Cost and round trip of the keymaps' crash journal
+ *
+ *   journal_bench [-n events] [-s seed]
+ *
+ * Times journal_key() on -n random key events (default 10M) against a call
+ * that does nothing, and journal_task() on scans where nothing changed,
+ * both through journal.c itself. Then fills the journal with random
+ * entries, "resets" by running journal_init() again, types the journal out
+ * with journal_dump() and checks the text against what was appended, with
+ * no modifier on while it's typed and the ones set before put back after.
+ * Also checks that a journal whose magic number is garbage starts over
+ * empty.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "qmk_sim.h"
+
+/* journal.c against a report, layers and clock the bench owns */
+
+#include "../lets_split/heartrobotninja/journal.c"
+
+uint32_t layer_state;
+uint32_t default_layer_state = 1;
+static report_keyboard_t report;
+report_keyboard_t *keyboard_report = &report;
+static uint16_t clock_ms;
+
+uint16_t timer_read(void)
+{
+  return clock_ms;
+}
+
+uint8_t biton32(uint32_t bits)
+{
+  return bits ? 31 - __builtin_clz(bits) : 0;
+}
+
+static uint8_t real_mods, oneshot_mods;
+
+uint8_t get_mods(void)
+{
+  return real_mods;
+}
+
+void set_mods(uint8_t mods)
+{
+  real_mods = mods;
+}
+
+void clear_mods(void)
+{
+  real_mods = 0;
+}
+
+void clear_weak_mods(void)
+{
+}
+
+uint8_t get_oneshot_mods(void)
+{
+  return oneshot_mods;
+}
+
+void set_oneshot_mods(uint8_t mods)
+{
+  oneshot_mods = mods;
+}
+
+void clear_oneshot_mods(void)
+{
+  oneshot_mods = 0;
+}
+
+/* What the host would see */
+
+static char screen[JOURNAL_SIZE * LINE_LENGTH + 1];
+static size_t screen_len;
+static uint8_t keys_down;
+static unsigned modded; // keys typed with a modifier on
+
+void add_key(uint8_t code)
+{
+  keys_down++;
+  modded += (real_mods | oneshot_mods) != 0;
+  char c = code == KC_0 ? '0' : code <= KC_9 && code >= KC_1 ? '1' + code - KC_1
+                              : code >= KC_A && code <= KC_F ? 'a' + code - KC_A
+                              : code == KC_SPC                ? ' '
+                              : code == KC_ENT                ? '\n'
+                                                              : '?';
+  if (screen_len < sizeof(screen) - 1)
+  {
+    screen[screen_len++] = c;
+  }
+}
+
+void del_key(uint8_t code)
+{
+  keys_down--;
+}
+
+void send_keyboard_report(void)
+{
+}
+
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t next_rand(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng >> 16;
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void nothing(uint16_t keycode, keyrecord_t *record)
+{
+}
+
+// Through a pointer, so neither call is inlined into the loop
+static void (*volatile record_fn)(uint16_t keycode, keyrecord_t *record);
+
+static double time_records(void (*fn)(uint16_t, keyrecord_t *), keyrecord_t *records,
+                           unsigned n, unsigned long events)
+{
+  record_fn = fn;
+  double t0 = now();
+  for (unsigned long i = 0; i < events; i++)
+  {
+    keyrecord_t *r = &records[i & (n - 1)];
+    record_fn(i, r);
+  }
+  return (now() - t0) / events * 1e9;
+}
+
+static int round_trip(void)
+{
+  journal_entry_t want[JOURNAL_SIZE];
+  int failures = 0;
+
+  journal.magic = next_rand();
+  journal_init();
+  if (journal.boots || journal.entries[1].type != JOURNAL_NONE)
+  {
+    printf("garbage journal kept\n");
+    failures++;
+  }
+  for (unsigned i = 0; i < 3 * JOURNAL_SIZE; i++)
+  {
+    clock_ms += next_rand() % 300;
+    journal_append(JOURNAL_KEY_DOWN + next_rand() % 4, next_rand(), next_rand() << 16 ^ next_rand(),
+                   clock_ms);
+  }
+  journal_init();
+  for (unsigned i = 0; i < JOURNAL_SIZE; i++)
+  {
+    want[i] = journal.entries[(journal.head + i) & (JOURNAL_SIZE - 1)];
+  }
+  if (journal.boots != 1 || want[JOURNAL_SIZE - 1].type != JOURNAL_BOOT)
+  {
+    printf("no boot entry after a reset\n");
+    failures++;
+  }
+
+  // A stuck Ctrl and a one-shot Shift, kept out of the dump and put back
+  screen_len = 0;
+  real_mods = MOD_BIT(KC_LCTL);
+  oneshot_mods = MOD_BIT(KC_LSFT);
+  journal_dump();
+  unsigned scans = 0;
+  do
+  {
+    journal_task();
+    scans++;
+  } while ((dump_left || dump_held != KC_NO) && scans < 10000);
+  screen[screen_len] = '\0';
+
+  const char *line = screen;
+  for (unsigned i = 0; i < JOURNAL_SIZE; i++)
+  {
+    unsigned time, type, arg, n = 0;
+    unsigned long data;
+    if (sscanf(line, "%4x %1x %2x %8lx\n%n", &time, &type, &arg, &data, &n) != 4 ||
+        time != want[i].time || type != want[i].type || arg != want[i].arg || data != want[i].data)
+    {
+      printf("entry %u: want %04x %x %02x %08lx, typed \"%.*s\"\n", i, want[i].time,
+             want[i].type, want[i].arg, (unsigned long)want[i].data, LINE_LENGTH - 1, line);
+      failures++;
+    }
+    line += n ? n : LINE_LENGTH;
+  }
+  bool restored = real_mods == MOD_BIT(KC_LCTL) && oneshot_mods == MOD_BIT(KC_LSFT);
+  printf("dump: %u entries in %u scans, %zu characters, keys left down: %u, "
+         "typed with mods: %u, mods put back: %s\n",
+         JOURNAL_SIZE, scans, screen_len, keys_down, modded, restored ? "yes" : "no");
+  return failures + (keys_down != 0) + (modded != 0) + !restored;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned long events = 10000000;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'n':
+      events = strtoul(optarg, NULL, 0);
+      break;
+    case 's':
+      rng ^= strtoull(optarg, NULL, 0) * 0x2545F4914F6CDD1DULL;
+      break;
+    default:
+      fprintf(stderr, "usage: journal_bench [-n events] [-s seed]\n");
+      return 2;
+    }
+  }
+
+  enum
+  {
+    RECORDS = 4096
+  };
+  static keyrecord_t records[RECORDS];
+  for (unsigned i = 0; i < RECORDS; i++)
+  {
+    records[i].event = (keyevent_t){
+            .key = {.row = next_rand() % 14, .col = next_rand() % 6},
+            .pressed = next_rand() % 2,
+            .time = next_rand(),
+    };
+  }
+
+  journal_init();
+  double base = time_records(nothing, records, RECORDS, events);
+  double keyed = time_records(journal_key, records, RECORDS, events);
+
+  double t0 = now();
+  for (unsigned long i = 0; i < events; i++)
+  {
+    journal_task();
+  }
+  double task = (now() - t0) / events * 1e9;
+
+  printf("journal_key: %.2f ns per event, %.2f ns over an empty call\n", keyed, keyed - base);
+  printf("journal_task: %.2f ns per scan with nothing to journal\n", task);
+  printf("journal: %zu bytes of .noinit for %d entries\n", sizeof(journal), JOURNAL_SIZE);
+  return round_trip() ? 1 : 0;
+}
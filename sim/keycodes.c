@@ -0,0 +1,320 @@
+#include <stdio.h>
+#include "sim.h"
+
+static const char *const basic_names[256] = {
+        [KC_NO] = "KC_NO",
+        [KC_ROLL_OVER] = "KC_ROLL_OVER",
+        [KC_POST_FAIL] = "KC_POST_FAIL",
+        [KC_UNDEFINED] = "KC_UNDEFINED",
+        [KC_A] = "KC_A",
+        [KC_B] = "KC_B",
+        [KC_C] = "KC_C",
+        [KC_D] = "KC_D",
+        [KC_E] = "KC_E",
+        [KC_F] = "KC_F",
+        [KC_G] = "KC_G",
+        [KC_H] = "KC_H",
+        [KC_I] = "KC_I",
+        [KC_J] = "KC_J",
+        [KC_K] = "KC_K",
+        [KC_L] = "KC_L",
+        [KC_M] = "KC_M",
+        [KC_N] = "KC_N",
+        [KC_O] = "KC_O",
+        [KC_P] = "KC_P",
+        [KC_Q] = "KC_Q",
+        [KC_R] = "KC_R",
+        [KC_S] = "KC_S",
+        [KC_T] = "KC_T",
+        [KC_U] = "KC_U",
+        [KC_V] = "KC_V",
+        [KC_W] = "KC_W",
+        [KC_X] = "KC_X",
+        [KC_Y] = "KC_Y",
+        [KC_Z] = "KC_Z",
+        [KC_1] = "KC_1",
+        [KC_2] = "KC_2",
+        [KC_3] = "KC_3",
+        [KC_4] = "KC_4",
+        [KC_5] = "KC_5",
+        [KC_6] = "KC_6",
+        [KC_7] = "KC_7",
+        [KC_8] = "KC_8",
+        [KC_9] = "KC_9",
+        [KC_0] = "KC_0",
+        [KC_ENTER] = "KC_ENT",
+        [KC_ESCAPE] = "KC_ESC",
+        [KC_BSPACE] = "KC_BSPC",
+        [KC_TAB] = "KC_TAB",
+        [KC_SPACE] = "KC_SPC",
+        [KC_MINUS] = "KC_MINS",
+        [KC_EQUAL] = "KC_EQL",
+        [KC_LBRACKET] = "KC_LBRC",
+        [KC_RBRACKET] = "KC_RBRC",
+        [KC_BSLASH] = "KC_BSLS",
+        [KC_NONUS_HASH] = "KC_NONUS_HASH",
+        [KC_SCOLON] = "KC_SCLN",
+        [KC_QUOTE] = "KC_QUOT",
+        [KC_GRAVE] = "KC_GRV",
+        [KC_COMMA] = "KC_COMM",
+        [KC_DOT] = "KC_DOT",
+        [KC_SLASH] = "KC_SLSH",
+        [KC_CAPSLOCK] = "KC_CAPS",
+        [KC_F1] = "KC_F1",
+        [KC_F2] = "KC_F2",
+        [KC_F3] = "KC_F3",
+        [KC_F4] = "KC_F4",
+        [KC_F5] = "KC_F5",
+        [KC_F6] = "KC_F6",
+        [KC_F7] = "KC_F7",
+        [KC_F8] = "KC_F8",
+        [KC_F9] = "KC_F9",
+        [KC_F10] = "KC_F10",
+        [KC_F11] = "KC_F11",
+        [KC_F12] = "KC_F12",
+        [KC_PSCREEN] = "KC_PSCREEN",
+        [KC_SCROLLLOCK] = "KC_SCROLLLOCK",
+        [KC_PAUSE] = "KC_PAUSE",
+        [KC_INSERT] = "KC_INS",
+        [KC_HOME] = "KC_HOME",
+        [KC_PGUP] = "KC_PGUP",
+        [KC_DELETE] = "KC_DEL",
+        [KC_END] = "KC_END",
+        [KC_PGDOWN] = "KC_PGDOWN",
+        [KC_RIGHT] = "KC_RGHT",
+        [KC_LEFT] = "KC_LEFT",
+        [KC_DOWN] = "KC_DOWN",
+        [KC_UP] = "KC_UP",
+        [KC_NUMLOCK] = "KC_NLCK",
+        [KC_KP_SLASH] = "KC_PSLS",
+        [KC_KP_ASTERISK] = "KC_PAST",
+        [KC_KP_MINUS] = "KC_PMNS",
+        [KC_KP_PLUS] = "KC_PPLS",
+        [KC_KP_ENTER] = "KC_PENT",
+        [KC_KP_1] = "KC_P1",
+        [KC_KP_2] = "KC_P2",
+        [KC_KP_3] = "KC_P3",
+        [KC_KP_4] = "KC_P4",
+        [KC_KP_5] = "KC_P5",
+        [KC_KP_6] = "KC_P6",
+        [KC_KP_7] = "KC_P7",
+        [KC_KP_8] = "KC_P8",
+        [KC_KP_9] = "KC_P9",
+        [KC_KP_0] = "KC_P0",
+        [KC_KP_DOT] = "KC_PDOT",
+        [KC_NONUS_BSLASH] = "KC_NONUS_BSLASH",
+        [KC_APPLICATION] = "KC_APPLICATION",
+        [KC_POWER] = "KC_POWER",
+        [KC_KP_EQUAL] = "KC_PEQL",
+        [KC_SYSTEM_POWER] = "KC_PWR",
+        [KC_SYSTEM_SLEEP] = "KC_SLEP",
+        [KC_SYSTEM_WAKE] = "KC_WAKE",
+        [KC_AUDIO_MUTE] = "KC_MUTE",
+        [KC_AUDIO_VOL_UP] = "KC_VOLU",
+        [KC_AUDIO_VOL_DOWN] = "KC_VOLD",
+        [KC_MEDIA_NEXT_TRACK] = "KC_MNXT",
+        [KC_MEDIA_PREV_TRACK] = "KC_MPRV",
+        [KC_MEDIA_STOP] = "KC_MSTP",
+        [KC_MEDIA_PLAY_PAUSE] = "KC_MPLY",
+        [KC_LCTRL] = "KC_LCTL",
+        [KC_LSHIFT] = "KC_LSFT",
+        [KC_LALT] = "KC_LALT",
+        [KC_LGUI] = "KC_LGUI",
+        [KC_RCTRL] = "KC_RCTL",
+        [KC_RSHIFT] = "KC_RSFT",
+        [KC_RALT] = "KC_RALT",
+        [KC_RGUI] = "KC_RGUI",
+        [KC_MS_UP] = "KC_MS_U",
+        [KC_MS_DOWN] = "KC_MS_D",
+        [KC_MS_LEFT] = "KC_MS_L",
+        [KC_MS_RIGHT] = "KC_MS_R",
+        [KC_MS_BTN1] = "KC_BTN1",
+        [KC_MS_BTN2] = "KC_BTN2",
+        [KC_MS_BTN3] = "KC_BTN3",
+        [KC_MS_BTN4] = "KC_MS_BTN4",
+        [KC_MS_BTN5] = "KC_MS_BTN5",
+        [KC_MS_WH_UP] = "KC_WH_U",
+        [KC_MS_WH_DOWN] = "KC_WH_D",
+        [KC_MS_WH_LEFT] = "KC_WH_L",
+        [KC_MS_WH_RIGHT] = "KC_WH_R",
+        [KC_MS_ACCEL0] = "KC_ACL0",
+        [KC_MS_ACCEL1] = "KC_ACL1",
+        [KC_MS_ACCEL2] = "KC_ACL2",
+};
+
+/* Shifted US layout symbols QMK gives their own names */
+static const struct
+{
+  uint16_t keycode;
+  const char *name;
+} shifted_names[] = {
+    {KC_TILD, "KC_TILD"},
+    {KC_EXLM, "KC_EXLM"},
+    {KC_AT, "KC_AT"},
+    {KC_HASH, "KC_HASH"},
+    {KC_DLR, "KC_DLR"},
+    {KC_PERC, "KC_PERC"},
+    {KC_CIRC, "KC_CIRC"},
+    {KC_AMPR, "KC_AMPR"},
+    {KC_ASTR, "KC_ASTR"},
+    {KC_LPRN, "KC_LPRN"},
+    {KC_RPRN, "KC_RPRN"},
+    {KC_UNDS, "KC_UNDS"},
+    {KC_PLUS, "KC_PLUS"},
+    {KC_LCBR, "KC_LCBR"},
+    {KC_RCBR, "KC_RCBR"},
+    {KC_PIPE, "KC_PIPE"},
+    {KC_COLN, "KC_COLN"},
+    {KC_DQT, "KC_DQT"},
+    {KC_LT, "KC_LT"},
+    {KC_GT, "KC_GT"},
+    {KC_QUES, "KC_QUES"},
+};
+
+static const char *const special_names[] = {
+    [RESET - RESET] = "RESET",
+    [DEBUG - RESET] = "DEBUG",
+    [KC_LEAD - RESET] = "KC_LEAD",
+    [RGB_TOG - RESET] = "RGB_TOG",
+    [RGB_MOD - RESET] = "RGB_MOD",
+    [RGB_HUI - RESET] = "RGB_HUI",
+    [RGB_HUD - RESET] = "RGB_HUD",
+    [RGB_SAI - RESET] = "RGB_SAI",
+    [RGB_SAD - RESET] = "RGB_SAD",
+    [RGB_VAI - RESET] = "RGB_VAI",
+    [RGB_VAD - RESET] = "RGB_VAD",
+};
+
+const char *sim_keycode_name(uint16_t keycode, char *buf, size_t len)
+{
+  if (keycode == KC_TRNS)
+  {
+    return "____";
+  }
+  if (keycode <= 0xFF)
+  {
+    if (basic_names[keycode])
+    {
+      return basic_names[keycode];
+    }
+    snprintf(buf, len, "0x%02X", keycode);
+    return buf;
+  }
+  for (size_t i = 0; i < sizeof(shifted_names) / sizeof(shifted_names[0]); i++)
+  {
+    if (shifted_names[i].keycode == keycode)
+    {
+      return shifted_names[i].name;
+    }
+  }
+  if (keycode >= RESET && keycode <= RGB_VAD)
+  {
+    return special_names[keycode - RESET];
+  }
+
+  char inner[32];
+  const char *kc = sim_keycode_name(keycode & 0xFF, inner, sizeof(inner));
+  if (keycode >= QK_MODS && keycode <= QK_MODS_MAX)
+  {
+    static const char *const mod_names[] = {"CTL", "SFT", "ALT", "GUI"};
+    for (int i = 0; i < 4; i++)
+    {
+      if (keycode & (QK_LCTL << i))
+      {
+        snprintf(buf, len, "%c%s(%s)", keycode & QK_RMODS_MIN ? 'R' : 'L', mod_names[i], kc);
+        return buf;
+      }
+    }
+  }
+  switch (keycode & 0xFF00)
+  {
+  case QK_MOMENTARY:
+    snprintf(buf, len, "MO(%d)", keycode & 0xFF);
+    return buf;
+  case QK_TOGGLE_LAYER:
+    snprintf(buf, len, "TG(%d)", keycode & 0xFF);
+    return buf;
+  case QK_ONE_SHOT_LAYER:
+    snprintf(buf, len, "OSL(%d)", keycode & 0xFF);
+    return buf;
+  case QK_ONE_SHOT_MOD:
+    snprintf(buf, len, "OSM(0x%02X)", keycode & 0xFF);
+    return buf;
+  case QK_TAP_DANCE:
+    snprintf(buf, len, "TD(%d)", keycode & 0xFF);
+    return buf;
+  case QK_LAYER_TAP_TOGGLE:
+    snprintf(buf, len, "TT(%d)", keycode & 0xFF);
+    return buf;
+  }
+  if ((keycode & 0xF000) == QK_MACRO)
+  {
+    snprintf(buf, len, "M(%d)", keycode & 0xFFF);
+  }
+  else if ((keycode & 0xF000) == QK_LAYER_TAP)
+  {
+    snprintf(buf, len, "LT(%d, %s)", (keycode >> 8) & 0xF, kc);
+  }
+  else if ((keycode & 0xE000) == QK_MOD_TAP)
+  {
+    snprintf(buf, len, "MT(0x%02X, %s)", (keycode >> 8) & 0x1F, kc);
+  }
+  else
+  {
+    snprintf(buf, len, "0x%04X", keycode);
+  }
+  return buf;
+}
+
+/* US layout, indexed from KC_A */
+static const char unshifted_chars[] =
+    "abcdefghijklmnopqrstuvwxyz1234567890\n\x1b\b\t -=[]\\#;'`,./";
+static const char shifted_chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ!@#$%^&*()\n\x1b\b\t _+{}|~:\"~<>?";
+static const char keypad_chars[] = "/*-+\n1234567890.";
+
+char sim_keycode_char(uint16_t keycode, bool shifted)
+{
+  if (keycode >= QK_MODS && keycode <= QK_MODS_MAX)
+  {
+    if ((keycode & 0x1F00) != QK_LSFT && (keycode & 0x1F00) != (QK_RMODS_MIN | QK_LSFT))
+    {
+      return 0;
+    }
+    shifted = true;
+    keycode &= 0xFF;
+  }
+  if (keycode >= KC_A && keycode <= KC_SLASH && keycode != KC_NONUS_HASH)
+  {
+    return (shifted ? shifted_chars : unshifted_chars)[keycode - KC_A];
+  }
+  if (!shifted && keycode >= KC_KP_SLASH && keycode <= KC_KP_DOT)
+  {
+    return keypad_chars[keycode - KC_KP_SLASH];
+  }
+  if (!shifted && keycode == KC_KP_EQUAL)
+  {
+    return '=';
+  }
+  return 0;
+}
+
+uint16_t sim_char_keycode(char c)
+{
+  for (uint16_t kc = KC_A; kc <= KC_SLASH; kc++)
+  {
+    if (kc == KC_NONUS_HASH)
+    {
+      continue;
+    }
+    if (unshifted_chars[kc - KC_A] == c)
+    {
+      return kc;
+    }
+    if (shifted_chars[kc - KC_A] == c)
+    {
+      return LSFT(kc);
+    }
+  }
+  return KC_NO;
+}
@@ -0,0 +1,592 @@
+/* Offline layout optimizer
+ *
+ *   layout_opt [-j threads] [-i iterations] [-s seed] [-L ms] [-F ms] [-P ms]
+ *              build/<board>.so corpus...
+ *
+ * Reads text/code corpora (a path of "-" is stdin) into bigram counts, then
+ * scores the keymap on how the corpus would be typed:
+ *
+ *   td wait     ms spent waiting out TAPPING_TERM between two taps on the same
+ *               tap dance key, which would otherwise merge into a double tap
+ *   layer       switches into a non-base layer between consecutive chars
+ *   same finger consecutive chars on different keys under the same finger
+ *   presses     key presses, counting one-shot shift and double taps
+ *
+ * The score weighs those as milliseconds: td wait as is, -L per layer switch,
+ * -F per same-finger bigram and -P per press. It then anneals over swaps of
+ * the symbols living on non-base layers and in tap dance double-tap roles,
+ * one independent search per core, and prints the best assignment found.
+ *
+ * The corpus is only ever seen as 128x128 bigram counts, so search cost does
+ * not depend on corpus size; reading is chunked and split across threads.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+
+#define NCHARS 128
+#define CHUNK (1 << 20)
+#define MAX_SLOTS 256
+#define MAX_PRODUCERS 1024
+
+typedef struct
+{
+  uint64_t uni[NCHARS];
+  uint64_t bi[NCHARS][NCHARS];
+} counts_t;
+
+/* Something that outputs keycode kc: a key on some layer, or one of the two
+ * taps of a tap dance. slot >= 0 when the keycode is up for reassignment.
+ */
+typedef struct
+{
+  int16_t slot;
+  uint16_t kc;
+  uint8_t layer;
+  uint8_t pos;
+  uint8_t finger;
+  uint8_t taps;
+  uint8_t td; // tap dance index + 1, 0 for a plain key
+} producer_t;
+
+typedef struct
+{
+  uint8_t layer;
+  uint8_t pos;
+  uint8_t finger;
+  uint8_t presses;
+  uint8_t td;
+  bool ok;
+} choice_t;
+
+typedef struct
+{
+  double td_wait_ms;
+  uint64_t layer_switches;
+  uint64_t same_finger;
+  uint64_t presses;
+  uint64_t missing;
+  double score;
+} metrics_t;
+
+static const sim_board_t *board;
+static counts_t corpus;
+static uint8_t active[NCHARS];
+static int nactive;
+
+static producer_t producers[MAX_PRODUCERS];
+static int nproducers;
+static uint16_t initial[MAX_SLOTS];
+static int nslots;
+static int shift_pos = -1; // OSM(MOD_LSFT) on the base layer
+static uint8_t shift_finger;
+
+static double layer_weight = 60;
+static double finger_weight = 80;
+static double press_weight = 30;
+
+/* Corpus reading */
+
+typedef struct
+{
+  int fd;
+  off_t start;
+  off_t end;
+  counts_t *counts;
+} reader_t;
+
+static void count_bytes(counts_t *c, const uint8_t *p, size_t n, int *prev)
+{
+  int a = *prev;
+  for (size_t i = 0; i < n; i++)
+  {
+    int b = p[i];
+    if (b == '\r')
+    {
+      continue;
+    }
+    if (b >= NCHARS || (b < ' ' && b != '\n' && b != '\t'))
+    {
+      a = -1;
+      continue;
+    }
+    c->uni[b]++;
+    if (a >= 0)
+    {
+      c->bi[a][b]++;
+    }
+    a = b;
+  }
+  *prev = a;
+}
+
+static void *read_range(void *arg)
+{
+  reader_t *r = arg;
+  uint8_t *buf = malloc(CHUNK);
+  int prev = -1;
+  off_t off = r->start;
+
+  if (off > 0)
+  {
+    // Seed the first bigram with the byte before our range
+    uint8_t b;
+    if (pread(r->fd, &b, 1, off - 1) == 1 && b < NCHARS && b >= ' ')
+    {
+      prev = b;
+    }
+  }
+  while (off < r->end)
+  {
+    size_t want = r->end - off < CHUNK ? (size_t)(r->end - off) : CHUNK;
+    ssize_t got = pread(r->fd, buf, want, off);
+    if (got <= 0)
+    {
+      break;
+    }
+    count_bytes(r->counts, buf, got, &prev);
+    off += got;
+  }
+  free(buf);
+  return NULL;
+}
+
+static void merge_counts(counts_t *dst, const counts_t *src)
+{
+  for (int a = 0; a < NCHARS; a++)
+  {
+    dst->uni[a] += src->uni[a];
+    for (int b = 0; b < NCHARS; b++)
+    {
+      dst->bi[a][b] += src->bi[a][b];
+    }
+  }
+}
+
+static uint64_t read_corpus(const char *path, int threads)
+{
+  if (strcmp(path, "-") == 0)
+  {
+    uint8_t *buf = malloc(CHUNK);
+    uint64_t total = 0;
+    int prev = -1;
+    size_t got;
+    while ((got = fread(buf, 1, CHUNK, stdin)) > 0)
+    {
+      count_bytes(&corpus, buf, got, &prev);
+      total += got;
+    }
+    free(buf);
+    return total;
+  }
+
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) < 0)
+  {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    exit(1);
+  }
+  if (st.st_size < (off_t)CHUNK * threads)
+  {
+    threads = 1;
+  }
+
+  pthread_t tid[threads];
+  reader_t readers[threads];
+  for (int t = 0; t < threads; t++)
+  {
+    readers[t].fd = fd;
+    readers[t].start = st.st_size * t / threads;
+    readers[t].end = st.st_size * (t + 1) / threads;
+    readers[t].counts = calloc(1, sizeof(counts_t));
+    pthread_create(&tid[t], NULL, read_range, &readers[t]);
+  }
+  for (int t = 0; t < threads; t++)
+  {
+    pthread_join(tid[t], NULL);
+    merge_counts(&corpus, readers[t].counts);
+    free(readers[t].counts);
+  }
+  close(fd);
+  return st.st_size;
+}
+
+/* Keymap model */
+
+static bool is_movable(uint16_t kc)
+{
+  // Symbols only: letters, digits and the keypad stay where they are
+  char c = sim_keycode_char(kc, false);
+  uint8_t base = kc & 0xFF;
+  return c > ' ' && c < 0x7F && !(c >= 'a' && c <= 'z') && !(c >= 'A' && c <= 'Z') &&
+         !(c >= '0' && c <= '9') && !(base >= KC_KP_SLASH && base <= KC_KP_EQUAL);
+}
+
+static void add_producer(uint16_t kc, uint8_t layer, uint8_t pos, uint8_t taps, uint8_t td,
+                         bool movable)
+{
+  if (nproducers == MAX_PRODUCERS)
+  {
+    return;
+  }
+  producer_t *p = &producers[nproducers++];
+  p->slot = -1;
+  if (movable && is_movable(kc) && nslots < MAX_SLOTS)
+  {
+    p->slot = nslots;
+    initial[nslots++] = kc;
+  }
+  p->kc = kc;
+  p->layer = layer;
+  p->pos = pos;
+  p->finger = board->fingers[pos];
+  p->taps = taps;
+  p->td = td;
+}
+
+static void load_board(void)
+{
+  int npos = board->rows * board->cols;
+
+  for (int layer = 0; layer < board->layers; layer++)
+  {
+    for (int pos = 0; pos < npos; pos++)
+    {
+      uint16_t kc = board->keymaps[layer * npos + pos];
+      if (kc == KC_NO || kc == KC_TRNS || !board->fingers[pos])
+      {
+        continue;
+      }
+      if (layer == 0 && kc == OSM(MOD_LSFT))
+      {
+        shift_pos = pos;
+        shift_finger = board->fingers[pos];
+      }
+      if ((kc & 0xFF00) == QK_TAP_DANCE)
+      {
+        uint16_t kc1, kc2;
+        uint8_t n = kc & 0xFF;
+        if (n < board->tap_dance_count && board->tap_dance_pair(n, &kc1, &kc2))
+        {
+          add_producer(kc1, layer, pos, 1, n + 1, false);
+          add_producer(kc2, layer, pos, 2, n + 1, true);
+        }
+        continue;
+      }
+      if (kc <= 0xFF || (kc & 0xFF00) == QK_LSFT)
+      {
+        add_producer(kc, layer, pos, 1, 0, layer > 0);
+      }
+    }
+  }
+}
+
+/* For every char, the cheapest way to type it in isolation under the given
+ * slot assignment. Context costs come from the bigram pass in evaluate().
+ */
+static void choose(const uint16_t *slots, choice_t *choice)
+{
+  double best[NCHARS];
+
+  memset(choice, 0, sizeof(choice_t) * NCHARS);
+  for (int i = 0; i < nproducers; i++)
+  {
+    const producer_t *p = &producers[i];
+    uint16_t kc = p->slot >= 0 ? slots[p->slot] : p->kc;
+
+    for (int shifted = 0; shifted < 2; shifted++)
+    {
+      bool via_osm = shifted && (kc & 0xFF00) != QK_LSFT;
+      if (via_osm && shift_pos < 0)
+      {
+        continue;
+      }
+      char c = sim_keycode_char(kc, shifted);
+      if (c <= 0 || (shifted && c == sim_keycode_char(kc, false)))
+      {
+        continue;
+      }
+      uint8_t presses = p->taps + via_osm;
+      double cost = presses * press_weight + (p->layer ? layer_weight : 0);
+      if (!choice[(int)c].ok || cost < best[(int)c])
+      {
+        best[(int)c] = cost;
+        choice[(int)c] = (choice_t){p->layer, p->pos, p->finger, presses, p->td, true};
+      }
+    }
+  }
+}
+
+static bool is_thumb(uint8_t finger)
+{
+  return finger == F_LT || finger == F_RT;
+}
+
+static void evaluate(const uint16_t *slots, metrics_t *m)
+{
+  choice_t choice[NCHARS];
+
+  choose(slots, choice);
+  memset(m, 0, sizeof(*m));
+  for (int i = 0; i < nactive; i++)
+  {
+    int a = active[i];
+    if (!choice[a].ok)
+    {
+      m->missing += corpus.uni[a];
+      continue;
+    }
+    m->presses += corpus.uni[a] * choice[a].presses;
+    for (int j = 0; j < nactive; j++)
+    {
+      int b = active[j];
+      uint64_t n = corpus.bi[a][b];
+      if (!n || !choice[b].ok)
+      {
+        continue;
+      }
+      const choice_t *x = &choice[a], *y = &choice[b];
+      if (y->layer && y->layer != x->layer)
+      {
+        m->layer_switches += n;
+      }
+      if (x->pos != y->pos && x->finger == y->finger && !is_thumb(x->finger))
+      {
+        m->same_finger += n;
+      }
+      if (x->td && x->td == y->td)
+      {
+        m->td_wait_ms += (double)n * board->tapping_term;
+      }
+    }
+  }
+  m->score = m->td_wait_ms + m->layer_switches * layer_weight + m->same_finger * finger_weight +
+             m->presses * press_weight;
+}
+
+/* Search */
+
+typedef struct
+{
+  unsigned seed;
+  long iterations;
+  uint16_t best[MAX_SLOTS];
+  metrics_t best_metrics;
+} search_t;
+
+static uint64_t xorshift(uint64_t *s)
+{
+  uint64_t x = *s;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return *s = x;
+}
+
+static void *anneal(void *arg)
+{
+  search_t *s = arg;
+  uint16_t cur[MAX_SLOTS];
+  metrics_t m;
+  uint64_t rng = 0x9E3779B97F4A7C15ULL * (s->seed + 1);
+
+  memcpy(cur, initial, sizeof(uint16_t) * nslots);
+  evaluate(cur, &m);
+  double cur_score = m.score;
+  s->best_metrics = m;
+  memcpy(s->best, cur, sizeof(uint16_t) * nslots);
+
+  double t0 = cur_score * 0.002 + 1;
+  for (long it = 0; it < s->iterations && nslots > 1; it++)
+  {
+    double temp = t0 * (1.0 - (double)it / s->iterations);
+    int a = xorshift(&rng) % nslots;
+    int b = xorshift(&rng) % nslots;
+    if (a == b || cur[a] == cur[b])
+    {
+      continue;
+    }
+    uint16_t tmp = cur[a];
+    cur[a] = cur[b];
+    cur[b] = tmp;
+
+    evaluate(cur, &m);
+    double delta = m.score - cur_score;
+    double u = (xorshift(&rng) >> 11) * (1.0 / 9007199254740992.0);
+    if (m.missing <= s->best_metrics.missing && (delta <= 0 || (temp > 0 && u < exp(-delta / temp))))
+    {
+      cur_score = m.score;
+      if (m.score < s->best_metrics.score)
+      {
+        s->best_metrics = m;
+        memcpy(s->best, cur, sizeof(uint16_t) * nslots);
+      }
+    }
+    else
+    {
+      cur[b] = cur[a];
+      cur[a] = tmp;
+    }
+  }
+  return NULL;
+}
+
+/* Output */
+
+static void print_metrics(const char *label, const metrics_t *m)
+{
+  printf("%-9s score %14.0f  td wait %10.0f ms  layer %10llu  same finger %10llu  presses %12llu",
+         label, m->score, m->td_wait_ms, (unsigned long long)m->layer_switches,
+         (unsigned long long)m->same_finger, (unsigned long long)m->presses);
+  if (m->missing)
+  {
+    printf("  untypable %llu", (unsigned long long)m->missing);
+  }
+  printf("\n");
+}
+
+static void print_changes(const uint16_t *best)
+{
+  char b1[32], b2[32], b3[32];
+  int changed = 0;
+
+  for (int i = 0; i < nproducers; i++)
+  {
+    const producer_t *p = &producers[i];
+    if (p->slot < 0 || best[p->slot] == p->kc)
+    {
+      continue;
+    }
+    const char *from = sim_keycode_name(p->kc, b1, sizeof(b1));
+    const char *to = sim_keycode_name(best[p->slot], b2, sizeof(b2));
+    if (p->td)
+    {
+      printf("  TD(%d) double tap:  %s -> %s\n", p->td - 1, from, to);
+    }
+    else
+    {
+      int row = p->pos / board->cols, col = p->pos % board->cols;
+      const char *under = sim_keycode_name(board->keymaps[p->pos], b3, sizeof(b3));
+      printf("  layer %d [%d][%d] (%s on base):  %s -> %s\n", p->layer, row, col, under, from, to);
+    }
+    changed++;
+  }
+  if (!changed)
+  {
+    printf("  no improvement found\n");
+  }
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void usage(void)
+{
+  fprintf(stderr, "usage: layout_opt [-j threads] [-i iterations] [-s seed] [-L layer_ms] "
+                  "[-F same_finger_ms] [-P press_ms] board.so corpus...\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  int threads = sysconf(_SC_NPROCESSORS_ONLN);
+  long iterations = 20000;
+  unsigned seed = 1;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "j:i:s:L:F:P:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'j':
+      threads = atoi(optarg);
+      break;
+    case 'i':
+      iterations = atol(optarg);
+      break;
+    case 's':
+      seed = strtoul(optarg, NULL, 0);
+      break;
+    case 'L':
+      layer_weight = atof(optarg);
+      break;
+    case 'F':
+      finger_weight = atof(optarg);
+      break;
+    case 'P':
+      press_weight = atof(optarg);
+      break;
+    default:
+      usage();
+    }
+  }
+  if (argc - optind < 2 || threads < 1)
+  {
+    usage();
+  }
+
+  board = sim_load(argv[optind]);
+  load_board();
+
+  double t = now();
+  uint64_t bytes = 0;
+  for (int i = optind + 1; i < argc; i++)
+  {
+    bytes += read_corpus(argv[i], threads);
+  }
+  double read_s = now() - t;
+  for (int c = 0; c < NCHARS; c++)
+  {
+    if (corpus.uni[c])
+    {
+      active[nactive++] = c;
+    }
+  }
+  printf("%s: %d layers, %d movable symbols; corpus %.1f MB in %.2f s (%.0f MB/s)\n",
+         board->keyboard, board->layers, nslots, bytes / 1e6, read_s,
+         read_s > 0 ? bytes / 1e6 / read_s : 0);
+
+  metrics_t base;
+  evaluate(initial, &base);
+  print_metrics("current", &base);
+
+  t = now();
+  search_t *searches = calloc(threads, sizeof(search_t));
+  pthread_t tid[threads];
+  for (int i = 0; i < threads; i++)
+  {
+    searches[i].seed = seed + i;
+    searches[i].iterations = iterations;
+    pthread_create(&tid[i], NULL, anneal, &searches[i]);
+  }
+  int best = 0;
+  for (int i = 0; i < threads; i++)
+  {
+    pthread_join(tid[i], NULL);
+    if (searches[i].best_metrics.score < searches[best].best_metrics.score)
+    {
+      best = i;
+    }
+  }
+  double search_s = now() - t;
+
+  print_metrics("best", &searches[best].best_metrics);
+  printf("searched %ld assignments on %d threads in %.2f s\n", iterations * threads, threads,
+         search_s);
+  print_changes(searches[best].best);
+  free(searches);
+  return 0;
+}
@@ -0,0 +1,62 @@
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "sim.h"
+
+/* dlopen hands back the existing handle for a file that is already loaded,
+ * so a second load of the same build goes through a private copy.
+ */
+static void *open_copy(const char *path)
+{
+  char tmp[] = "/tmp/sim_keymap_XXXXXX";
+  int out = mkstemp(tmp);
+  FILE *in = fopen(path, "rb");
+  if (out < 0 || !in)
+  {
+    perror(path);
+    exit(1);
+  }
+  char buf[65536];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+  {
+    if (write(out, buf, n) != (ssize_t)n)
+    {
+      perror(tmp);
+      exit(1);
+    }
+  }
+  fclose(in);
+  close(out);
+  void *handle = dlopen(tmp, RTLD_NOW | RTLD_LOCAL);
+  unlink(tmp);
+  return handle;
+}
+
+const sim_board_t *sim_load(const char *path)
+{
+  // RTLD_LOCAL keeps two builds of the same keymap from sharing globals
+  void *handle = dlopen(path, RTLD_NOW | RTLD_LOCAL | RTLD_NOLOAD);
+  if (handle)
+  {
+    dlclose(handle);
+    handle = open_copy(path);
+  }
+  else
+  {
+    handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  }
+  if (!handle)
+  {
+    fprintf(stderr, "%s\n", dlerror());
+    exit(1);
+  }
+  const sim_board_t *board = dlsym(handle, "sim_board");
+  if (!board)
+  {
+    fprintf(stderr, "%s: no sim_board, not a keymap build\n", path);
+    exit(1);
+  }
+  return board;
+}
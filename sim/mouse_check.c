@@ -0,0 +1,190 @@
+/* Report timing and curve accuracy of the keymaps' mouse keys
+ *
+ *   mouse_check keymap.so [hold ms ...]
+ *
+ * Holds each pointer and wheel direction, straight and diagonal, for each
+ * time given (default 10 100 250 500 1000 2000) through the keymap's
+ * process_mouse_keys(), scanning at the sim's 1ms. Checks that reports come
+ * exactly MOUSE_CURVE_INTERVAL apart, and compares the distance moved with
+ * the curve mouse_curve.h was generated from, integrated over the same
+ * time. The difference allowed is the tap's one unit plus 2%.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "../lets_split/heartrobotninja/mouse_curve.h"
+#include "../lets_split/heartrobotninja/mouse_keys.h"
+
+typedef struct
+{
+  const sim_board_t *board;
+  unsigned reports;
+  uint64_t last_us;
+  uint64_t min_gap_us, max_gap_us;
+  unsigned off_interval; // gaps that aren't a whole number of intervals
+  long x, y, v, h;
+} host_t;
+
+static void host_mouse(void *ctx, const report_mouse_t *r)
+{
+  host_t *host = ctx;
+  uint64_t now = host->board->now_us();
+  if (host->reports)
+  {
+    uint64_t gap = now - host->last_us;
+    if (gap < host->min_gap_us)
+    {
+      host->min_gap_us = gap;
+    }
+    if (gap > host->max_gap_us)
+    {
+      host->max_gap_us = gap;
+    }
+    host->off_interval += gap % (MOUSE_CURVE_INTERVAL * 1000) != 0;
+  }
+  host->reports++;
+  host->last_us = now;
+  host->x += r->x;
+  host->y += r->y;
+  host->v += r->v;
+  host->h += r->h;
+}
+
+// Pixels the curve covers in the first ms milliseconds
+static double curve_px(double ms)
+{
+  double ramp = MOUSE_CURVE_RAMP, t = ms < ramp ? ms : ramp;
+  double span = MOUSE_CURVE_MAX - MOUSE_CURVE_START;
+  double px = MOUSE_CURVE_START * t / 1000 + span * t * t * t / (3 * ramp * ramp) / 1000;
+  if (ms > ramp)
+  {
+    px += MOUSE_CURVE_MAX * (ms - ramp) / 1000;
+  }
+  return px;
+}
+
+// Each key of a motion from a matrix position of its own, as releases are matched by it
+static void press(const sim_board_t *board, uint8_t k, uint16_t keycode, bool pressed)
+{
+  keyrecord_t record = {.event = {.key = {.row = 0, .col = k},
+                                  .pressed = pressed,
+                                  .time = board->now_us() / 1000 | 1}};
+  board->mouse_keys(keycode, &record);
+}
+
+typedef struct
+{
+  const char *name;
+  uint16_t keys[2];
+  bool wheel;
+} motion_t;
+
+static const motion_t motions[] = {
+        {"right", {KC_MS_R, KC_NO}, false},
+        {"up", {KC_MS_U, KC_NO}, false},
+        {"down+left", {KC_MS_D, KC_MS_L}, false},
+        {"wheel down", {KC_WH_D, KC_NO}, true},
+        {"wheel right", {KC_WH_R, KC_NO}, true},
+};
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    fprintf(stderr, "usage: mouse_check keymap.so [hold ms ...]\n");
+    return 2;
+  }
+  const sim_board_t *board = sim_load(argv[1]);
+  if (!board->mouse_keys)
+  {
+    fprintf(stderr, "%s: keymap has no mouse_keys.c\n", argv[1]);
+    return 2;
+  }
+
+  static const int default_holds[] = {10, 100, 250, 500, 1000, 2000};
+  int holds[64], nholds = 0;
+  for (int i = 2; i < argc && nholds < 64; i++)
+  {
+    holds[nholds++] = atoi(argv[i]);
+  }
+  if (!nholds)
+  {
+    memcpy(holds, default_holds, sizeof(default_holds));
+    nholds = sizeof(default_holds) / sizeof(default_holds[0]);
+  }
+
+  host_t host;
+  board->set_mouse_hook(host_mouse, &host);
+  board->init();
+
+  printf("#  curve: %d-%d px/s over %dms, %zu bytes; reports every %dms\n", MOUSE_CURVE_START,
+         MOUSE_CURVE_MAX, MOUSE_CURVE_RAMP, sizeof(mouse_curve), MOUSE_CURVE_INTERVAL);
+  printf("%-12s %6s %7s %9s %8s %8s %7s\n", "motion", "hold", "reports", "gap ms", "moved",
+         "curve", "error");
+
+  int failures = 0;
+  for (size_t m = 0; m < sizeof(motions) / sizeof(motions[0]); m++)
+  {
+    const motion_t *mo = &motions[m];
+    for (int i = 0; i < nholds; i++)
+    {
+      host = (host_t){.board = board, .min_gap_us = UINT64_MAX};
+      for (int k = 0; k < 2 && mo->keys[k]; k++)
+      {
+        press(board, k, mo->keys[k], true);
+      }
+      for (int ms = 0; ms < holds[i]; ms++)
+      {
+        board->scan();
+      }
+      for (int k = 0; k < 2 && mo->keys[k]; k++)
+      {
+        press(board, k, mo->keys[k], false);
+      }
+      for (int ms = 0; ms < 50; ms++)
+      {
+        board->scan();
+      }
+
+      /* Reports land at 0, 10, 20ms... up to the release, each moving for
+       * the interval after it. A tap starts one unit short of whole, so it
+       * moves at once.
+       */
+      unsigned steps = holds[i] / MOUSE_CURVE_INTERVAL + 1;
+      double ideal = curve_px(steps * MOUSE_CURVE_INTERVAL);
+      bool diagonal = mo->keys[1] != KC_NO;
+      if (diagonal)
+      {
+        ideal /= sqrt(2);
+      }
+      if (mo->wheel)
+      {
+        ideal /= 1 << MOUSE_KEYS_WHEEL_SHIFT;
+      }
+      // Per axis; a diagonal moves the same on both
+      long moved = mo->wheel ? labs(host.v) + labs(host.h) : labs(host.x) + labs(host.y);
+      if (diagonal)
+      {
+        moved /= 2;
+      }
+      double error = moved - ideal;
+      // A report with nothing to move is skipped, so a gap can be several intervals
+      bool timing_ok = !host.off_interval;
+      bool curve_ok = fabs(error) <= 1 + 0.02 * ideal;
+
+      char gaps[32] = "-";
+      if (host.reports >= 2)
+      {
+        snprintf(gaps, sizeof(gaps), "%.0f-%.0f", host.min_gap_us / 1000.0,
+                 host.max_gap_us / 1000.0);
+      }
+      printf("%-12s %6d %7u %9s %8ld %8.1f %+7.1f%s%s\n", mo->name, holds[i], host.reports, gaps,
+             moved, ideal, error, timing_ok ? "" : "  TIMING", curve_ok ? "" : "  OFF CURVE");
+      failures += !timing_ok || !curve_ok;
+    }
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/* Tabulates the keymaps' mouse key acceleration curve
+ *
+ *   mouse_curve_gen [-i interval_ms] [-s start_px_s] [-m max_px_s] [-r ramp_ms] out.h
+ *
+ * Pointer speed starts at -s and rises with the square of the time a key
+ * has been held, reaching -m after -r. The table holds one entry per report
+ * sent every -i ms: the distance the curve covers over that report's
+ * interval in 1/16 px, so mouse_keys.c adds it to a fraction and shifts
+ * instead of dividing, and the sum of the entries follows the curve.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define MOUSE_CURVE_UNIT 16
+
+static int start = 100, max = 1500, ramp = 1000;
+
+// Pixels covered in the first ms milliseconds
+static double curve_px(double ms)
+{
+  double t = ms < ramp ? ms : ramp;
+  double px = start * t / 1000 + (double)(max - start) * t * t * t / (3.0 * ramp * ramp) / 1000;
+  if (ms > ramp)
+  {
+    px += max * (ms - ramp) / 1000;
+  }
+  return px;
+}
+
+int main(int argc, char **argv)
+{
+  int interval = 10;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "i:s:m:r:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'i':
+      interval = atoi(optarg);
+      break;
+    case 's':
+      start = atoi(optarg);
+      break;
+    case 'm':
+      max = atoi(optarg);
+      break;
+    case 'r':
+      ramp = atoi(optarg);
+      break;
+    default:
+      optind = argc;
+      break;
+    }
+  }
+  if (optind + 1 != argc || interval <= 0 || ramp < interval || start <= 0 || max < start)
+  {
+    fprintf(stderr,
+            "usage: mouse_curve_gen [-i interval_ms] [-s start_px_s] [-m max_px_s] [-r ramp_ms] out.h\n");
+    return 2;
+  }
+  if (max * interval * MOUSE_CURVE_UNIT / 1000 > 255)
+  {
+    fprintf(stderr, "%d px/s is over 255/16 px per %dms report\n", max, interval);
+    return 2;
+  }
+
+  int steps = ramp / interval + 1;
+  FILE *out = fopen(argv[optind], "w");
+  if (!out)
+  {
+    perror(argv[optind]);
+    return 1;
+  }
+  fprintf(out, "// Generated by sim/build/mouse_curve_gen, do not edit\n"
+               "// %d px/s rising to %d px/s over %dms, squared; 1/16 px per %dms report\n\n"
+               "#ifndef MOUSE_CURVE_H\n"
+               "#define MOUSE_CURVE_H\n\n"
+               "#define MOUSE_CURVE_INTERVAL %d\n"
+               "#define MOUSE_CURVE_START %d\n"
+               "#define MOUSE_CURVE_MAX %d\n"
+               "#define MOUSE_CURVE_RAMP %d\n"
+               "#define MOUSE_CURVE_STEPS %d\n\n"
+               "static const uint8_t PROGMEM mouse_curve[MOUSE_CURVE_STEPS] = {",
+          start, max, ramp, interval, interval, start, max, ramp, steps);
+  double owed = 0;
+  for (int i = 0; i < steps; i++)
+  {
+    // Carry the rounding over so the running total stays on the curve
+    owed += (curve_px((i + 1) * interval) - curve_px(i * interval)) * MOUSE_CURVE_UNIT;
+    int entry = (int)lround(owed);
+    owed -= entry;
+    fprintf(out, "%s%d,", i % 16 ? " " : "\n        ", entry);
+  }
+  fprintf(out, "\n};\n\n#endif\n");
+  fclose(out);
+
+  printf("%s: %d entries, %d-%d px/s over %dms\n", argv[optind], steps, start, max, ramp);
+  return 0;
+}
@@ -0,0 +1,745 @@
+/* Key event pipeline: matrix scan -> tapping -> quantum -> action
+ *
+ * Follows QMK/TMK as of these keymaps: keyboard_task handles at most one
+ * matrix change per scan, keycodes are looked up with the layers active when
+ * the event is processed, process_record_user runs before tap dance and
+ * leader, and tap keys (OSM, TT, LT, MT) are held back until they resolve to
+ * a tap or a hold.
+ */
+
+#include "eeconfig.h"
+#include "sim_runtime.h"
+
+#ifndef ONESHOT_TAP_TOGGLE
+#define ONESHOT_TAP_TOGGLE 0
+#endif
+
+static uint32_t matrix[32];
+static uint32_t matrix_prev[32];
+
+uint32_t sim_resets;
+
+/* Keymap lookup */
+
+static uint16_t keymap_keycode(uint8_t layer, keypos_t key)
+{
+  return SIM_KEYMAP_AT(&sim_board, layer, key.row, key.col);
+}
+
+static uint8_t layer_switch_get_layer(keypos_t key)
+{
+  uint32_t layers = layer_state | default_layer_state;
+  // Layers that are on, highest first
+  while (layers)
+  {
+    uint8_t i = 31 - __builtin_clz(layers);
+    if (i < sim_board.layers && keymap_keycode(i, key) != KC_TRNS)
+    {
+      return i;
+    }
+    layers &= ~(1UL << i);
+  }
+  return 0;
+}
+
+static uint16_t event_keycode(keypos_t key)
+{
+  return keymap_keycode(layer_switch_get_layer(key), key);
+}
+
+/* Mods */
+
+static uint8_t action_mods(uint8_t mods)
+{
+  // 5-bit mods as used by OSM() and MT(): bit 4 selects the right hand
+  return (mods & 0x10) ? (mods & 0x0F) << 4 : mods & 0x0F;
+}
+
+static uint8_t keycode_mods(uint16_t keycode)
+{
+  return action_mods((keycode >> 8) & 0x1F);
+}
+
+void register_mods(uint8_t mods)
+{
+  if (mods)
+  {
+    add_mods(mods);
+    send_keyboard_report();
+  }
+}
+
+void unregister_mods(uint8_t mods)
+{
+  if (mods)
+  {
+    del_mods(mods);
+    send_keyboard_report();
+  }
+}
+
+static uint8_t oneshot_locked_mods;
+
+/* Tap dance */
+#ifdef TAP_DANCE_ENABLE
+static uint16_t last_td;
+
+static void tap_dance_finished(qk_tap_dance_action_t *action)
+{
+  if (action->state.finished)
+  {
+    return;
+  }
+  action->state.finished = true;
+  if (action->fn.on_dance_finished)
+  {
+    action->fn.on_dance_finished(&action->state, action->user_data);
+  }
+}
+
+static void preprocess_tap_dance(uint16_t keycode, keyrecord_t *record)
+{
+  if (!record->event.pressed)
+  {
+    return;
+  }
+  for (uint8_t i = 0; i < sim_board.tap_dance_count; i++)
+  {
+    qk_tap_dance_action_t *action = &tap_dance_actions[i];
+    if (action->state.count)
+    {
+      if (keycode == action->state.keycode && keycode == last_td)
+      {
+        continue;
+      }
+      action->state.interrupted = true;
+      tap_dance_finished(action);
+      reset_tap_dance(&action->state);
+    }
+  }
+}
+
+static bool process_tap_dance(uint16_t keycode, keyrecord_t *record)
+{
+  if ((keycode & 0xFF00) != QK_TAP_DANCE || (keycode & 0xFF) >= sim_board.tap_dance_count)
+  {
+    return true;
+  }
+  qk_tap_dance_action_t *action = &tap_dance_actions[keycode & 0xFF];
+  action->state.pressed = record->event.pressed;
+  if (record->event.pressed)
+  {
+    action->state.keycode = keycode;
+    action->state.count++;
+    action->state.timer = timer_read();
+    if (action->fn.on_each_tap)
+    {
+      action->fn.on_each_tap(&action->state, action->user_data);
+    }
+    last_td = keycode;
+  }
+  else if (action->state.count && action->state.finished)
+  {
+    reset_tap_dance(&action->state);
+  }
+  return true;
+}
+
+static void matrix_scan_tap_dance(void)
+{
+  for (uint8_t i = 0; i < sim_board.tap_dance_count; i++)
+  {
+    qk_tap_dance_action_t *action = &tap_dance_actions[i];
+    if (action->state.count && timer_elapsed(action->state.timer) > TAPPING_TERM)
+    {
+      tap_dance_finished(action);
+      reset_tap_dance(&action->state);
+    }
+  }
+}
+#endif
+
+/* Leader */
+
+static bool process_leader(uint16_t keycode, keyrecord_t *record)
+{
+  if (record->event.pressed)
+  {
+    if (!leading && keycode == KC_LEAD)
+    {
+      leader_start();
+      leading = true;
+      leader_time = timer_read();
+      leader_sequence_size = 0;
+      memset(leader_sequence, 0, sizeof(leader_sequence));
+      return false;
+    }
+    if (leading && timer_elapsed(leader_time) < LEADER_TIMEOUT)
+    {
+      if (leader_sequence_size < sizeof(leader_sequence) / sizeof(leader_sequence[0]))
+      {
+        leader_sequence[leader_sequence_size++] = keycode;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Quantum */
+
+static bool process_record_quantum(uint16_t keycode, keyrecord_t *record)
+{
+#ifdef TAP_DANCE_ENABLE
+  preprocess_tap_dance(keycode, record);
+#endif
+
+  if (!(process_record_user(keycode, record) &&
+#ifdef TAP_DANCE_ENABLE
+        process_tap_dance(keycode, record) &&
+#endif
+        process_leader(keycode, record)))
+  {
+    return false;
+  }
+
+  switch (keycode)
+  {
+  case RESET:
+    if (record->event.pressed)
+    {
+      sim_resets++;
+    }
+    return false;
+  case RGB_TOG:
+    if (record->event.pressed)
+    {
+      rgblight_toggle();
+    }
+    return false;
+  case RGB_MOD:
+    if (record->event.pressed)
+    {
+      rgblight_step();
+    }
+    return false;
+  case RGB_HUI:
+  case RGB_HUD:
+  case RGB_SAI:
+  case RGB_SAD:
+  case RGB_VAI:
+  case RGB_VAD:
+    return false;
+  }
+  return true;
+}
+
+/* Actions */
+
+static void process_oneshot_mod(uint8_t mods, keyrecord_t *record)
+{
+  uint8_t tap_count = record->tap.count;
+
+  if (record->event.pressed)
+  {
+    if (tap_count == 0)
+    {
+      register_mods(mods | get_oneshot_mods());
+    }
+    else if (tap_count == 1)
+    {
+      set_oneshot_mods(mods | get_oneshot_mods());
+    }
+    else if (ONESHOT_TAP_TOGGLE > 1 && tap_count == ONESHOT_TAP_TOGGLE)
+    {
+      clear_oneshot_mods();
+      oneshot_locked_mods = mods;
+      register_mods(mods);
+    }
+    else
+    {
+      register_mods(mods | get_oneshot_mods());
+    }
+  }
+  else
+  {
+    if (tap_count == 0)
+    {
+      clear_oneshot_mods();
+      unregister_mods(mods);
+    }
+    else if (tap_count == 1)
+    {
+      // Retain oneshot mods, unless this tap ends a lock
+      if (ONESHOT_TAP_TOGGLE > 1 && (mods & get_mods()))
+      {
+        oneshot_locked_mods = 0;
+        clear_oneshot_mods();
+        unregister_mods(mods);
+      }
+    }
+    else if (ONESHOT_TAP_TOGGLE > 1 && tap_count == ONESHOT_TAP_TOGGLE)
+    {
+      // Locked until the next tap
+    }
+    else
+    {
+      clear_oneshot_mods();
+      unregister_mods(mods);
+    }
+  }
+}
+
+static void process_action(uint16_t keycode, keyrecord_t *record)
+{
+  keyevent_t event = record->event;
+  uint8_t tap_count = record->tap.count;
+
+  if (event.pressed)
+  {
+    // clear the potential weak mods left by previously pressed keys
+    clear_weak_mods();
+  }
+
+  if (keycode <= 0xFF)
+  {
+    if (keycode == KC_TRNS)
+    {
+      return;
+    }
+    if (event.pressed)
+    {
+      register_code(keycode);
+    }
+    else
+    {
+      unregister_code(keycode);
+    }
+    return;
+  }
+
+  if (keycode >= QK_MODS && keycode <= QK_MODS_MAX)
+  {
+    uint8_t code = keycode & 0xFF;
+    uint8_t mods = keycode_mods(keycode);
+    if (event.pressed)
+    {
+      IS_MOD(code) ? add_mods(mods) : add_weak_mods(mods);
+      send_keyboard_report();
+      register_code(code);
+    }
+    else
+    {
+      unregister_code(code);
+      IS_MOD(code) ? del_mods(mods) : del_weak_mods(mods);
+      send_keyboard_report();
+    }
+    return;
+  }
+
+  if ((keycode & 0xF000) == QK_MACRO)
+  {
+    action_get_macro(record, keycode & 0xFF, (keycode >> 8) & 0xF);
+    return;
+  }
+
+  if ((keycode & 0xF000) == QK_LAYER_TAP)
+  {
+    uint8_t layer = (keycode >> 8) & 0xF;
+    uint8_t code = keycode & 0xFF;
+    if (event.pressed)
+    {
+      tap_count > 0 ? register_code(code) : layer_on(layer);
+    }
+    else
+    {
+      tap_count > 0 ? unregister_code(code) : layer_off(layer);
+    }
+    return;
+  }
+
+  if ((keycode & 0xE000) == QK_MOD_TAP)
+  {
+    uint8_t code = keycode & 0xFF;
+    uint8_t mods = keycode_mods(keycode);
+    if (event.pressed)
+    {
+      tap_count > 0 ? register_code(code) : register_mods(mods);
+    }
+    else
+    {
+      tap_count > 0 ? unregister_code(code) : unregister_mods(mods);
+    }
+    return;
+  }
+
+  uint8_t val = keycode & 0xFF;
+  switch (keycode & 0xFF00)
+  {
+  case QK_TO:
+    if (event.pressed)
+    {
+      layer_move(val & 0x0F);
+    }
+    break;
+  case QK_MOMENTARY:
+  case QK_ONE_SHOT_LAYER:
+    event.pressed ? layer_on(val) : layer_off(val);
+    break;
+  case QK_DEF_LAYER:
+    if (event.pressed)
+    {
+      default_layer_set(1UL << val);
+    }
+    break;
+  case QK_TOGGLE_LAYER:
+    if (!event.pressed)
+    {
+      layer_invert(val);
+    }
+    break;
+  case QK_ONE_SHOT_MOD:
+    process_oneshot_mod(action_mods(val), record);
+    break;
+  case QK_LAYER_TAP_TOGGLE:
+    if (event.pressed ? tap_count < TAPPING_TOGGLE : tap_count <= TAPPING_TOGGLE)
+    {
+      layer_invert(val);
+    }
+    break;
+  }
+}
+
+static void process_record(keyrecord_t *record)
+{
+  uint16_t keycode = event_keycode(record->event.key);
+
+  if (!process_record_quantum(keycode, record))
+  {
+    return;
+  }
+  process_action(keycode, record);
+}
+
+/* Tapping
+ *
+ * A tap key press is held back until it is released within TAPPING_TERM (a
+ * tap, processed press+release with tap.count 1), another key is pressed or
+ * the term runs out (a hold, tap.count 0). Pressing it again within the term
+ * of the previous tap continues the count immediately.
+ */
+
+static keyrecord_t tapping_key;
+static bool tapping_pending;
+
+static keypos_t last_tap_key;
+static uint16_t last_tap_time;
+static uint8_t last_tap_count;
+
+static bool sequence_held;
+static keypos_t sequence_key;
+static uint8_t sequence_count;
+
+static bool is_tap_keycode(uint16_t keycode)
+{
+  uint16_t range = keycode & 0xFF00;
+  return range == QK_ONE_SHOT_MOD || range == QK_LAYER_TAP_TOGGLE ||
+         (keycode & 0xF000) == QK_LAYER_TAP || (keycode & 0xE000) == QK_MOD_TAP;
+}
+
+static bool same_key(keypos_t a, keypos_t b)
+{
+  return a.row == b.row && a.col == b.col;
+}
+
+static void tapping_resolve_hold(void)
+{
+  if (tapping_pending)
+  {
+    tapping_pending = false;
+    tapping_key.tap.count = 0;
+    process_record(&tapping_key);
+  }
+}
+
+static void action_exec(keyevent_t event)
+{
+  keyrecord_t record = {.event = event};
+
+  if (event.pressed)
+  {
+    if (tapping_pending && !same_key(tapping_key.event.key, event.key))
+    {
+      tapping_resolve_hold();
+    }
+    if (is_tap_keycode(event_keycode(event.key)))
+    {
+      if (last_tap_count && same_key(last_tap_key, event.key) &&
+          (uint16_t)(event.time - last_tap_time) < TAPPING_TERM)
+      {
+        sequence_held = true;
+        sequence_key = event.key;
+        sequence_count = last_tap_count < 15 ? last_tap_count + 1 : 15;
+        record.tap.count = sequence_count;
+        last_tap_time = event.time;
+        process_record(&record);
+      }
+      else
+      {
+        tapping_key = record;
+        tapping_pending = true;
+        last_tap_count = 0;
+      }
+      return;
+    }
+    last_tap_count = 0;
+    process_record(&record);
+    return;
+  }
+
+  if (tapping_pending && same_key(tapping_key.event.key, event.key))
+  {
+    tapping_pending = false;
+    if ((uint16_t)(event.time - tapping_key.event.time) < TAPPING_TERM)
+    {
+      tapping_key.tap.count = 1;
+      process_record(&tapping_key);
+      record.tap.count = 1;
+      process_record(&record);
+      last_tap_key = event.key;
+      last_tap_time = tapping_key.event.time;
+      last_tap_count = 1;
+      return;
+    }
+    tapping_key.tap.count = 0;
+    process_record(&tapping_key);
+  }
+  else if (sequence_held && same_key(sequence_key, event.key))
+  {
+    sequence_held = false;
+    record.tap.count = sequence_count;
+    last_tap_count = sequence_count;
+  }
+  process_record(&record);
+}
+
+static void tapping_tick(void)
+{
+  if (tapping_pending && timer_elapsed(tapping_key.event.time) >= TAPPING_TERM)
+  {
+    tapping_resolve_hold();
+  }
+}
+
+/* Split link
+ *
+ * On a split board only the master half is on USB. It reads the slave
+ * half's rows over the serial link, which takes link_delay scans, so the
+ * matrix it sees mixes its own rows as of now with the slave's as of then.
+ * keyboard_task takes that as it is, and a slave key can be processed after
+ * a master key pressed after it.
+ *
+ * With link_merged, both halves' rows go through the keymap's split_link.c
+ * instead, told the link's latency as its config.h would, and keyboard_task
+ * takes the matrix that hands on.
+ */
+
+#define LINK_MAX 16 // power of two, longer than any delay set
+
+static uint8_t link_delay;
+static bool link_merged;
+static bool master_right;
+
+static uint8_t master_scans;
+static uint32_t sent_rows[LINK_MAX][32]; // slave rows by master scan
+static uint32_t merged[32];              // the matrix split_link.c hands on
+static uint8_t link_busy; // scans until what the slave last sent is in
+
+bool sim_set_link(bool right_is_master, uint8_t delay, bool merge)
+{
+  master_right = right_is_master;
+  link_delay = delay < LINK_MAX ? delay : LINK_MAX - 1;
+  link_merged = merge && sim_merge_init(!right_is_master, link_delay);
+  return link_merged == merge;
+}
+
+static bool is_slave_row(uint8_t row)
+{
+  return sim_board.split_rows && (row < sim_board.split_rows) == master_right;
+}
+
+static void link_scan(void)
+{
+  uint8_t slot = master_scans % LINK_MAX;
+
+  for (uint8_t r = 0; r < sim_board.rows; r++)
+  {
+    if (is_slave_row(r))
+    {
+      if (matrix[r] != sent_rows[(uint8_t)(slot - 1) % LINK_MAX][r])
+      {
+        link_busy = link_delay + 1;
+      }
+      sent_rows[slot][r] = matrix[r];
+    }
+  }
+  if (link_merged)
+  {
+    uint8_t arrived = (uint8_t)(master_scans - link_delay) % LINK_MAX;
+    uint8_t slave = master_right ? 0 : sim_board.split_rows;
+    uint8_t local = master_right ? sim_board.split_rows : 0;
+    sim_merge_scan(&matrix[local], &sent_rows[arrived][slave], merged);
+  }
+}
+
+/* Keyboard task */
+
+sim_event_fn sim_event_hook;
+void *sim_event_ctx;
+
+void sim_set_event_hook(sim_event_fn fn, void *ctx)
+{
+  sim_event_hook = fn;
+  sim_event_ctx = ctx;
+}
+
+void sim_key(uint8_t row, uint8_t col, bool pressed)
+{
+  if (pressed)
+  {
+    matrix[row] |= 1UL << col;
+  }
+  else
+  {
+    matrix[row] &= ~(1UL << col);
+  }
+}
+
+/* Nothing for a scan to act on now: the matrix as the master sees it is
+ * settled and no transition is queued. Timers may still be running.
+ */
+bool sim_quiet(void)
+{
+  for (uint8_t r = 0; r < sim_board.rows; r++)
+  {
+    if (matrix[r] != matrix_prev[r])
+    {
+      return false;
+    }
+  }
+  return !link_busy && !(link_merged && sim_merge_pending());
+}
+
+// Milliseconds until a tap key or a tap dance times out, 0xFFFF when none is waiting
+uint16_t sim_due_in(void)
+{
+  uint16_t due = 0xFFFF;
+  if (tapping_pending)
+  {
+    uint16_t elapsed = timer_elapsed(tapping_key.event.time);
+    due = elapsed >= TAPPING_TERM ? 0 : TAPPING_TERM - elapsed;
+  }
+#ifdef TAP_DANCE_ENABLE
+  for (uint8_t i = 0; i < sim_board.tap_dance_count; i++)
+  {
+    qk_tap_dance_action_t *action = &tap_dance_actions[i];
+    // One finished and still held waits for its release
+    if (action->state.count && !(action->state.finished && action->state.pressed))
+    {
+      // Finished on the scan after TAPPING_TERM, see matrix_scan_tap_dance
+      uint16_t elapsed = timer_elapsed(action->state.timer);
+      uint16_t in = elapsed > TAPPING_TERM ? 0 : TAPPING_TERM + 1 - elapsed;
+      due = in < due ? in : due;
+    }
+  }
+#endif
+  return due;
+}
+
+bool sim_idle(void)
+{
+  return sim_quiet() && sim_due_in() == 0xFFFF;
+}
+
+void sim_skip(uint32_t scans)
+{
+  sim_clock_us += (uint64_t)scans * SIM_SCAN_US;
+  /* Quiet, so each scan skipped would have sent the slave rows as they are.
+   * Only the last link_delay of them are read again, and the last one is
+   * what the next scan compares with.
+   */
+  if (sim_board.split_rows)
+  {
+    uint8_t first = master_right ? 0 : sim_board.split_rows;
+    uint8_t last = master_right ? sim_board.split_rows : sim_board.rows;
+    uint32_t sent = link_delay ? link_delay : 1;
+    for (uint32_t i = scans > sent ? scans - sent + 1 : 1; i <= scans; i++)
+    {
+      uint8_t slot = (master_scans + i) % LINK_MAX;
+      for (uint8_t r = first; r < last; r++)
+      {
+        sent_rows[slot][r] = matrix[r];
+      }
+    }
+  }
+  master_scans += scans;
+}
+
+static void key_event(keypos_t key, bool pressed)
+{
+  keyevent_t event = {.key = key, .pressed = pressed, .time = timer_read() | 1};
+  if (sim_event_hook)
+  {
+    sim_event_hook(sim_event_ctx, event);
+  }
+  action_exec(event);
+  matrix_prev[key.row] ^= 1UL << key.col;
+}
+
+void sim_scan(void)
+{
+  sim_clock_us += SIM_SCAN_US;
+
+#ifdef TAP_DANCE_ENABLE
+  matrix_scan_tap_dance();
+#endif
+  matrix_scan_user();
+
+  tapping_tick();
+  master_scans++;
+  if (link_busy)
+  {
+    link_busy--;
+  }
+  if (sim_board.split_rows)
+  {
+    link_scan();
+  }
+
+  // one key per task call, as keyboard_task does
+  for (uint8_t r = 0; r < sim_board.rows; r++)
+  {
+    // The matrix as the master has it
+    uint32_t seen = link_merged    ? merged[r]
+                    : is_slave_row(r) ? sent_rows[(uint8_t)(master_scans - link_delay) % LINK_MAX][r]
+                                      : matrix[r];
+    uint32_t change = seen ^ matrix_prev[r];
+    if (change)
+    {
+      uint8_t c = __builtin_ctz(change);
+      key_event((keypos_t){.row = r, .col = c}, (seen >> c) & 1);
+      return;
+    }
+  }
+}
+
+void sim_init(void)
+{
+  sim_eeprom_erase();
+  if (!eeconfig_is_enabled())
+  {
+    eeconfig_init();
+  }
+  default_layer_set(eeconfig_read_default_layer());
+  matrix_init_user();
+}
@@ -0,0 +1,6 @@
+#ifndef SIM_ACTION_UTIL_H
+#define SIM_ACTION_UTIL_H
+
+#include "qmk_sim.h"
+
+#endif
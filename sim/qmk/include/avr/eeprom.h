@@ -0,0 +1,30 @@
+#ifndef SIM_AVR_EEPROM_H
+#define SIM_AVR_EEPROM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ATmega32U4 EEPROM: 1KB, ~3.4ms per byte write. Like avr-libc, every access
+ * waits for a write in progress to finish first; in the sim that wait
+ * advances the clock, so stalls show up in timing.
+ */
+#define E2END 0x3FF
+#define EEPROM_WRITE_US 3400
+
+bool eeprom_is_ready(void);
+#define eeprom_busy_wait() \
+  do                       \
+  {                        \
+  } while (!eeprom_is_ready())
+
+uint8_t eeprom_read_byte(const uint8_t *addr);
+uint16_t eeprom_read_word(const uint16_t *addr);
+uint32_t eeprom_read_dword(const uint32_t *addr);
+void eeprom_write_byte(uint8_t *addr, uint8_t value);
+void eeprom_write_word(uint16_t *addr, uint16_t value);
+void eeprom_write_dword(uint32_t *addr, uint32_t value);
+void eeprom_update_byte(uint8_t *addr, uint8_t value);
+void eeprom_update_word(uint16_t *addr, uint16_t value);
+void eeprom_update_dword(uint32_t *addr, uint32_t value);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef SIM_DEBUG_H
+#define SIM_DEBUG_H
+
+#include "qmk_sim.h"
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef SIM_EECONFIG_H
+#define SIM_EECONFIG_H
+
+#include "qmk_sim.h"
+
+#define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEED
+
+/* EEPROM parameter address */
+#define EECONFIG_MAGIC (uint16_t *)0
+#define EECONFIG_DEBUG (uint8_t *)2
+#define EECONFIG_DEFAULT_LAYER (uint8_t *)3
+#define EECONFIG_KEYMAP (uint8_t *)4
+#define EECONFIG_MOUSEKEY_ACCEL (uint8_t *)5
+#define EECONFIG_BACKLIGHT (uint8_t *)6
+#define EECONFIG_AUDIO (uint8_t *)7
+#define EECONFIG_RGBLIGHT (uint32_t *)8
+#define EECONFIG_UNICODEMODE (uint8_t *)12
+
+bool eeconfig_is_enabled(void);
+void eeconfig_init(void);
+uint8_t eeconfig_read_default_layer(void);
+void eeconfig_update_default_layer(uint8_t val);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef SIM_HOST_H
+#define SIM_HOST_H
+
+#include "qmk_sim.h"
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SIM_LETS_SPLIT_H
+#define SIM_LETS_SPLIT_H
+
+#include "qmk_sim.h"
+
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 6
+
+// Each half scans its own 4 rows; the slave's go to the master over serial
+#define SIM_SPLIT_ROWS 4
+
+/* Same mapping as rev1/rev1.h: rows 0-3 are the left half, rows 4-7 the
+ * right half with its columns mirrored.
+ */
+// clang-format off
+#define KEYMAP(                                                         \
+    k00, k01, k02, k03, k04, k05, k45, k44, k43, k42, k41, k40,        \
+    k10, k11, k12, k13, k14, k15, k55, k54, k53, k52, k51, k50,        \
+    k20, k21, k22, k23, k24, k25, k65, k64, k63, k62, k61, k60,        \
+    k30, k31, k32, k33, k34, k35, k75, k74, k73, k72, k71, k70)        \
+  {                                                                     \
+    { k00, k01, k02, k03, k04, k05 },                                   \
+    { k10, k11, k12, k13, k14, k15 },                                   \
+    { k20, k21, k22, k23, k24, k25 },                                   \
+    { k30, k31, k32, k33, k34, k35 },                                   \
+    { k40, k41, k42, k43, k44, k45 },                                   \
+    { k50, k51, k52, k53, k54, k55 },                                   \
+    { k60, k61, k62, k63, k64, k65 },                                   \
+    { k70, k71, k72, k73, k74, k75 }                                    \
+  }
+
+#define SIM_FINGERS KEYMAP(                                             \
+    F_LP, F_LP, F_LR, F_LM, F_LI, F_LI, F_RI, F_RI, F_RM, F_RR, F_RP, F_RP, \
+    F_LP, F_LP, F_LR, F_LM, F_LI, F_LI, F_RI, F_RI, F_RM, F_RR, F_RP, F_RP, \
+    F_LP, F_LP, F_LR, F_LM, F_LI, F_LI, F_RI, F_RI, F_RM, F_RR, F_RP, F_RP, \
+    F_LP, F_LR, F_LM, F_LI, F_LT, F_LT, F_RT, F_RT, F_RI, F_RM, F_RR, F_RP)
+// clang-format on
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef SIM_MATRIX_H
+#define SIM_MATRIX_H
+
+#include <stdint.h>
+
+#if (MATRIX_COLS <= 8)
+typedef uint8_t matrix_row_t;
+#elif (MATRIX_COLS <= 16)
+typedef uint16_t matrix_row_t;
+#else
+typedef uint32_t matrix_row_t;
+#endif
+
+#endif
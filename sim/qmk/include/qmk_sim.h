@@ -0,0 +1,605 @@
+#ifndef QMK_SIM_H
+#define QMK_SIM_H
+
+/* Host stand-in for the parts of QMK/TMK the keymaps use
+ *
+ * Every QMK header a keymap includes (action_layer.h, eeconfig.h, ...) maps
+ * to this file, so keymap.c compiles unchanged on the host. Keycode values,
+ * mod bits and struct layouts follow QMK closely enough that code which
+ * relies on them (tap(LSFT(KC_O)) truncating to KC_O, KC_TRNS == 1, ...)
+ * behaves the same here as on the board.
+ *
+ * The keymap's config.h is force-included by the sim Makefile, the same way
+ * QMK picks it up ahead of the keyboard's own config.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+
+/* Basic keycodes (HID usage page 0x07, plus TMK's system/consumer/mouse) */
+enum hid_keyboard_keypad_usage
+{
+  KC_NO = 0x00,
+  KC_ROLL_OVER,
+  KC_POST_FAIL,
+  KC_UNDEFINED,
+  KC_A,
+  KC_B,
+  KC_C,
+  KC_D,
+  KC_E,
+  KC_F,
+  KC_G,
+  KC_H,
+  KC_I,
+  KC_J,
+  KC_K,
+  KC_L,
+  KC_M,
+  KC_N,
+  KC_O,
+  KC_P,
+  KC_Q,
+  KC_R,
+  KC_S,
+  KC_T,
+  KC_U,
+  KC_V,
+  KC_W,
+  KC_X,
+  KC_Y,
+  KC_Z,
+  KC_1,
+  KC_2,
+  KC_3,
+  KC_4,
+  KC_5,
+  KC_6,
+  KC_7,
+  KC_8,
+  KC_9,
+  KC_0,
+  KC_ENTER,
+  KC_ESCAPE,
+  KC_BSPACE,
+  KC_TAB,
+  KC_SPACE,
+  KC_MINUS,
+  KC_EQUAL,
+  KC_LBRACKET,
+  KC_RBRACKET,
+  KC_BSLASH,
+  KC_NONUS_HASH,
+  KC_SCOLON,
+  KC_QUOTE,
+  KC_GRAVE,
+  KC_COMMA,
+  KC_DOT,
+  KC_SLASH,
+  KC_CAPSLOCK,
+  KC_F1,
+  KC_F2,
+  KC_F3,
+  KC_F4,
+  KC_F5,
+  KC_F6,
+  KC_F7,
+  KC_F8,
+  KC_F9,
+  KC_F10,
+  KC_F11,
+  KC_F12,
+  KC_PSCREEN,
+  KC_SCROLLLOCK,
+  KC_PAUSE,
+  KC_INSERT,
+  KC_HOME,
+  KC_PGUP,
+  KC_DELETE,
+  KC_END,
+  KC_PGDOWN,
+  KC_RIGHT,
+  KC_LEFT,
+  KC_DOWN,
+  KC_UP,
+  KC_NUMLOCK,
+  KC_KP_SLASH,
+  KC_KP_ASTERISK,
+  KC_KP_MINUS,
+  KC_KP_PLUS,
+  KC_KP_ENTER,
+  KC_KP_1,
+  KC_KP_2,
+  KC_KP_3,
+  KC_KP_4,
+  KC_KP_5,
+  KC_KP_6,
+  KC_KP_7,
+  KC_KP_8,
+  KC_KP_9,
+  KC_KP_0,
+  KC_KP_DOT,
+  KC_NONUS_BSLASH,
+  KC_APPLICATION,
+  KC_POWER,
+  KC_KP_EQUAL,
+
+  KC_SYSTEM_POWER = 0xA5,
+  KC_SYSTEM_SLEEP,
+  KC_SYSTEM_WAKE,
+  KC_AUDIO_MUTE,
+  KC_AUDIO_VOL_UP,
+  KC_AUDIO_VOL_DOWN,
+  KC_MEDIA_NEXT_TRACK,
+  KC_MEDIA_PREV_TRACK,
+  KC_MEDIA_STOP,
+  KC_MEDIA_PLAY_PAUSE,
+
+  KC_LCTRL = 0xE0,
+  KC_LSHIFT,
+  KC_LALT,
+  KC_LGUI,
+  KC_RCTRL,
+  KC_RSHIFT,
+  KC_RALT,
+  KC_RGUI,
+
+  KC_MS_UP = 0xF0,
+  KC_MS_DOWN,
+  KC_MS_LEFT,
+  KC_MS_RIGHT,
+  KC_MS_BTN1,
+  KC_MS_BTN2,
+  KC_MS_BTN3,
+  KC_MS_BTN4,
+  KC_MS_BTN5,
+  KC_MS_WH_UP,
+  KC_MS_WH_DOWN,
+  KC_MS_WH_LEFT,
+  KC_MS_WH_RIGHT,
+  KC_MS_ACCEL0,
+  KC_MS_ACCEL1,
+  KC_MS_ACCEL2,
+};
+
+#define KC_TRANSPARENT 0x01
+#define KC_TRNS KC_TRANSPARENT
+
+#define KC_ENT KC_ENTER
+#define KC_ESC KC_ESCAPE
+#define KC_BSPC KC_BSPACE
+#define KC_SPC KC_SPACE
+#define KC_MINS KC_MINUS
+#define KC_EQL KC_EQUAL
+#define KC_LBRC KC_LBRACKET
+#define KC_RBRC KC_RBRACKET
+#define KC_BSLS KC_BSLASH
+#define KC_SCLN KC_SCOLON
+#define KC_QUOT KC_QUOTE
+#define KC_GRV KC_GRAVE
+#define KC_COMM KC_COMMA
+#define KC_SLSH KC_SLASH
+#define KC_CAPS KC_CAPSLOCK
+#define KC_DEL KC_DELETE
+#define KC_INS KC_INSERT
+#define KC_RGHT KC_RIGHT
+#define KC_NLCK KC_NUMLOCK
+#define KC_PSLS KC_KP_SLASH
+#define KC_PAST KC_KP_ASTERISK
+#define KC_PMNS KC_KP_MINUS
+#define KC_PPLS KC_KP_PLUS
+#define KC_PENT KC_KP_ENTER
+#define KC_PDOT KC_KP_DOT
+#define KC_PEQL KC_KP_EQUAL
+#define KC_P0 KC_KP_0
+#define KC_P1 KC_KP_1
+#define KC_P2 KC_KP_2
+#define KC_P3 KC_KP_3
+#define KC_P4 KC_KP_4
+#define KC_P5 KC_KP_5
+#define KC_P6 KC_KP_6
+#define KC_P7 KC_KP_7
+#define KC_P8 KC_KP_8
+#define KC_P9 KC_KP_9
+#define KC_PWR KC_SYSTEM_POWER
+#define KC_SLEP KC_SYSTEM_SLEEP
+#define KC_WAKE KC_SYSTEM_WAKE
+#define KC_MUTE KC_AUDIO_MUTE
+#define KC_VOLU KC_AUDIO_VOL_UP
+#define KC_VOLD KC_AUDIO_VOL_DOWN
+#define KC_MNXT KC_MEDIA_NEXT_TRACK
+#define KC_MPRV KC_MEDIA_PREV_TRACK
+#define KC_MSTP KC_MEDIA_STOP
+#define KC_MPLY KC_MEDIA_PLAY_PAUSE
+#define KC_LCTL KC_LCTRL
+#define KC_LSFT KC_LSHIFT
+#define KC_RCTL KC_RCTRL
+#define KC_RSFT KC_RSHIFT
+#define KC_MS_U KC_MS_UP
+#define KC_MS_D KC_MS_DOWN
+#define KC_MS_L KC_MS_LEFT
+#define KC_MS_R KC_MS_RIGHT
+#define KC_BTN1 KC_MS_BTN1
+#define KC_BTN2 KC_MS_BTN2
+#define KC_BTN3 KC_MS_BTN3
+#define KC_WH_U KC_MS_WH_UP
+#define KC_WH_D KC_MS_WH_DOWN
+#define KC_WH_L KC_MS_WH_LEFT
+#define KC_WH_R KC_MS_WH_RIGHT
+#define KC_ACL0 KC_MS_ACCEL0
+#define KC_ACL1 KC_MS_ACCEL1
+#define KC_ACL2 KC_MS_ACCEL2
+
+#define IS_KEY(code) (KC_A <= (code) && (code) <= KC_KP_EQUAL)
+#define IS_MOD(code) (KC_LCTRL <= (code) && (code) <= KC_RGUI)
+#define IS_SYSTEM(code) (KC_SYSTEM_POWER <= (code) && (code) <= KC_SYSTEM_WAKE)
+#define IS_CONSUMER(code) (KC_AUDIO_MUTE <= (code) && (code) <= KC_MEDIA_PLAY_PAUSE)
+#define IS_MOUSEKEY(code) (KC_MS_UP <= (code) && (code) <= KC_MS_ACCEL2)
+
+/* Mods */
+#define MOD_LCTL 0x01
+#define MOD_LSFT 0x02
+#define MOD_LALT 0x04
+#define MOD_LGUI 0x08
+#define MOD_RCTL 0x11
+#define MOD_RSFT 0x12
+#define MOD_RALT 0x14
+#define MOD_RGUI 0x18
+
+#define MOD_INDEX(code) ((code)&0x07)
+#define MOD_BIT(code) (1 << MOD_INDEX(code))
+
+/* Quantum keycode ranges */
+enum quantum_keycodes
+{
+  QK_TMK = 0x0000,
+  QK_MODS = 0x0100,
+  QK_LCTL = 0x0100,
+  QK_LSFT = 0x0200,
+  QK_LALT = 0x0400,
+  QK_LGUI = 0x0800,
+  QK_RMODS_MIN = 0x1000,
+  QK_MODS_MAX = 0x1FFF,
+  QK_FUNCTION = 0x2000,
+  QK_FUNCTION_MAX = 0x2FFF,
+  QK_MACRO = 0x3000,
+  QK_MACRO_MAX = 0x3FFF,
+  QK_LAYER_TAP = 0x4000,
+  QK_LAYER_TAP_MAX = 0x4FFF,
+  QK_TO = 0x5000,
+  QK_TO_MAX = 0x50FF,
+  QK_MOMENTARY = 0x5100,
+  QK_MOMENTARY_MAX = 0x51FF,
+  QK_DEF_LAYER = 0x5200,
+  QK_DEF_LAYER_MAX = 0x52FF,
+  QK_TOGGLE_LAYER = 0x5300,
+  QK_TOGGLE_LAYER_MAX = 0x53FF,
+  QK_ONE_SHOT_LAYER = 0x5400,
+  QK_ONE_SHOT_LAYER_MAX = 0x54FF,
+  QK_ONE_SHOT_MOD = 0x5500,
+  QK_ONE_SHOT_MOD_MAX = 0x55FF,
+  QK_TAP_DANCE = 0x5700,
+  QK_TAP_DANCE_MAX = 0x57FF,
+  QK_LAYER_TAP_TOGGLE = 0x5800,
+  QK_LAYER_TAP_TOGGLE_MAX = 0x58FF,
+  QK_MOD_TAP = 0x6000,
+  QK_MOD_TAP_MAX = 0x7FFF,
+
+  RESET = 0x5C00,
+  DEBUG,
+  KC_LEAD,
+  RGB_TOG,
+  RGB_MOD,
+  RGB_HUI,
+  RGB_HUD,
+  RGB_SAI,
+  RGB_SAD,
+  RGB_VAI,
+  RGB_VAD,
+
+  SAFE_RANGE = 0x5F00,
+};
+
+#define LCTL(kc) ((kc) | QK_LCTL)
+#define LSFT(kc) ((kc) | QK_LSFT)
+#define LALT(kc) ((kc) | QK_LALT)
+#define LGUI(kc) ((kc) | QK_LGUI)
+#define RCTL(kc) ((kc) | QK_RMODS_MIN | QK_LCTL)
+#define RSFT(kc) ((kc) | QK_RMODS_MIN | QK_LSFT)
+#define RALT(kc) ((kc) | QK_RMODS_MIN | QK_LALT)
+#define RGUI(kc) ((kc) | QK_RMODS_MIN | QK_LGUI)
+#define S(kc) LSFT(kc)
+
+#define KC_TILD LSFT(KC_GRV)
+#define KC_EXLM LSFT(KC_1)
+#define KC_AT LSFT(KC_2)
+#define KC_HASH LSFT(KC_3)
+#define KC_DLR LSFT(KC_4)
+#define KC_PERC LSFT(KC_5)
+#define KC_CIRC LSFT(KC_6)
+#define KC_AMPR LSFT(KC_7)
+#define KC_ASTR LSFT(KC_8)
+#define KC_LPRN LSFT(KC_9)
+#define KC_RPRN LSFT(KC_0)
+#define KC_UNDS LSFT(KC_MINS)
+#define KC_PLUS LSFT(KC_EQL)
+#define KC_LCBR LSFT(KC_LBRC)
+#define KC_RCBR LSFT(KC_RBRC)
+#define KC_PIPE LSFT(KC_BSLS)
+#define KC_COLN LSFT(KC_SCLN)
+#define KC_DQT LSFT(KC_QUOT)
+#define KC_LT LSFT(KC_COMM)
+#define KC_GT LSFT(KC_DOT)
+#define KC_QUES LSFT(KC_SLSH)
+
+#define M(kc) ((kc) | QK_MACRO)
+#define LT(layer, kc) ((kc) | QK_LAYER_TAP | (((layer)&0xF) << 8))
+#define TO(layer) (QK_TO | (1 << 4) | ((layer)&0xFF))
+#define MO(layer) (QK_MOMENTARY | ((layer)&0xFF))
+#define DF(layer) (QK_DEF_LAYER | ((layer)&0xFF))
+#define TG(layer) (QK_TOGGLE_LAYER | ((layer)&0xFF))
+#define OSL(layer) (QK_ONE_SHOT_LAYER | ((layer)&0xFF))
+#define OSM(mod) (QK_ONE_SHOT_MOD | ((mod)&0xFF))
+#define TD(n) (QK_TAP_DANCE | ((n)&0xFF))
+#define TT(layer) (QK_LAYER_TAP_TOGGLE | ((layer)&0xFF))
+#define MT(mod, kc) ((kc) | QK_MOD_TAP | (((mod)&0x1F) << 8))
+
+/* Events */
+typedef struct
+{
+  uint8_t col;
+  uint8_t row;
+} keypos_t;
+
+typedef struct
+{
+  keypos_t key;
+  bool pressed;
+  uint16_t time;
+} keyevent_t;
+
+typedef struct
+{
+  bool interrupted : 1;
+  bool reserved2 : 1;
+  bool reserved1 : 1;
+  bool reserved0 : 1;
+  uint8_t count : 4;
+} tap_t;
+
+typedef struct
+{
+  keyevent_t event;
+  tap_t tap;
+} keyrecord_t;
+
+/* Keymap */
+typedef struct
+{
+  bool swap_control_capslock : 1;
+  bool capslock_to_control : 1;
+  bool swap_lalt_lgui : 1;
+  bool swap_ralt_rgui : 1;
+  bool no_gui : 1;
+  bool swap_grave_esc : 1;
+  bool swap_backslash_backspace : 1;
+  bool nkro : 1;
+} keymap_config_t;
+
+extern keymap_config_t keymap_config;
+
+/* Layers */
+extern uint32_t layer_state;
+extern uint32_t default_layer_state;
+
+void default_layer_set(uint32_t state);
+void layer_clear(void);
+void layer_move(uint8_t layer);
+void layer_on(uint8_t layer);
+void layer_off(uint8_t layer);
+void layer_invert(uint8_t layer);
+void update_tri_layer(uint8_t layer1, uint8_t layer2, uint8_t layer3);
+uint8_t biton32(uint32_t bits);
+
+/* Reports */
+typedef struct
+{
+  uint8_t mods;
+  uint8_t bits[32]; // NKRO bitmap, one bit per usage 0x00-0xFF
+} report_keyboard_t;
+
+extern report_keyboard_t *keyboard_report;
+
+typedef struct
+{
+  uint8_t buttons;
+  int8_t x;
+  int8_t y;
+  int8_t v;
+  int8_t h;
+} report_mouse_t;
+
+#define MOUSE_BTN1 (1 << 0)
+#define MOUSE_BTN2 (1 << 1)
+#define MOUSE_BTN3 (1 << 2)
+#define MOUSE_BTN4 (1 << 3)
+#define MOUSE_BTN5 (1 << 4)
+
+void host_mouse_send(report_mouse_t *report);
+
+/* Lock LEDs, as the host last set them */
+#define USB_LED_NUM_LOCK 0
+#define USB_LED_CAPS_LOCK 1
+#define USB_LED_SCROLL_LOCK 2
+
+uint8_t host_keyboard_leds(void);
+
+void add_key(uint8_t code);
+void del_key(uint8_t code);
+void register_code(uint8_t code);
+void unregister_code(uint8_t code);
+void register_code16(uint16_t code);
+void unregister_code16(uint16_t code);
+void register_mods(uint8_t mods);
+void unregister_mods(uint8_t mods);
+void add_mods(uint8_t mods);
+void del_mods(uint8_t mods);
+void set_mods(uint8_t mods);
+void clear_mods(void);
+uint8_t get_mods(void);
+void add_weak_mods(uint8_t mods);
+void del_weak_mods(uint8_t mods);
+void clear_weak_mods(void);
+void clear_keyboard(void);
+void send_keyboard_report(void);
+
+/* One shot mods */
+void set_oneshot_mods(uint8_t mods);
+void clear_oneshot_mods(void);
+uint8_t get_oneshot_mods(void);
+bool has_oneshot_mods_timed_out(void);
+
+/* Timers and delays */
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+void wait_ms(uint16_t ms);
+void wait_us(uint16_t us);
+#define _delay_ms(ms) wait_ms(ms)
+
+/* Macros */
+typedef uint8_t macro_t;
+#define MACRO_NONE ((macro_t *)0)
+#define MACRO(...) ((macro_t *)0)
+
+const macro_t *action_get_macro(keyrecord_t *record, uint8_t id, uint8_t opt);
+
+void send_string(const char *str);
+#define SEND_STRING(str) send_string(PSTR(str))
+
+/* Tap dance */
+typedef struct
+{
+  uint8_t count;
+  uint16_t keycode;
+  uint16_t timer;
+  bool pressed;
+  bool finished;
+  bool interrupted;
+} qk_tap_dance_state_t;
+
+typedef void (*qk_tap_dance_user_fn_t)(qk_tap_dance_state_t *state, void *user_data);
+
+typedef struct
+{
+  struct
+  {
+    qk_tap_dance_user_fn_t on_each_tap;
+    qk_tap_dance_user_fn_t on_dance_finished;
+    qk_tap_dance_user_fn_t on_reset;
+  } fn;
+  qk_tap_dance_state_t state;
+  void *user_data;
+} qk_tap_dance_action_t;
+
+typedef struct
+{
+  uint16_t kc1;
+  uint16_t kc2;
+} qk_tap_dance_pair_t;
+
+void qk_tap_dance_pair_finished(qk_tap_dance_state_t *state, void *user_data);
+void qk_tap_dance_pair_reset(qk_tap_dance_state_t *state, void *user_data);
+void reset_tap_dance(qk_tap_dance_state_t *state);
+
+#define ACTION_TAP_DANCE_DOUBLE(kc1, kc2)                                   \
+  {                                                                         \
+    .fn = {NULL, qk_tap_dance_pair_finished, qk_tap_dance_pair_reset},      \
+    .user_data = (void *)&((qk_tap_dance_pair_t){kc1, kc2}),                \
+  }
+
+#define ACTION_TAP_DANCE_FN(user_fn) \
+  {                                  \
+    .fn = {NULL, user_fn, NULL},     \
+    .user_data = NULL,               \
+  }
+
+#define ACTION_TAP_DANCE_FN_ADVANCED(user_fn_on_each_tap, user_fn_on_dance_finished, user_fn_on_dance_reset) \
+  {                                                                                                       \
+    .fn = {user_fn_on_each_tap, user_fn_on_dance_finished, user_fn_on_dance_reset},                       \
+    .user_data = NULL,                                                                                    \
+  }
+
+extern qk_tap_dance_action_t tap_dance_actions[];
+
+/* Leader */
+extern bool leading;
+extern uint16_t leader_time;
+extern uint16_t leader_sequence[5];
+extern uint8_t leader_sequence_size;
+
+void leader_start(void);
+void leader_end(void);
+
+#define LEADER_EXTERNS() \
+  extern bool leading;   \
+  extern uint16_t leader_time; \
+  extern uint16_t leader_sequence[5]; \
+  extern uint8_t leader_sequence_size
+#define LEADER_DICTIONARY() if (leading && timer_elapsed(leader_time) > LEADER_TIMEOUT)
+#define SEQ_ONE_KEY(key) if (leader_sequence[0] == (key) && leader_sequence[1] == 0 && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
+#define SEQ_TWO_KEYS(key1, key2) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
+#define SEQ_THREE_KEYS(key1, key2, key3) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == 0 && leader_sequence[4] == 0)
+#define SEQ_FOUR_KEYS(key1, key2, key3, key4) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == (key4) && leader_sequence[4] == 0)
+
+/* RGB underglow, state only */
+void rgblight_init(void);
+void rgblight_enable(void);
+void rgblight_toggle(void);
+void rgblight_mode(uint8_t mode);
+void rgblight_step(void);
+void rgblight_setrgb(uint8_t r, uint8_t g, uint8_t b);
+void rgblight_effect_knight(uint8_t interval);
+
+/* Debug output is dropped */
+#define print(s)
+#define println(s)
+#define xprintf(...)
+#define dprint(s)
+#define dprintf(...)
+#define uprintf(...)
+
+/* Finger that presses each key, used by the layout tools. Boards give a
+ * SIM_FINGERS initializer built with their own KEYMAP() macro so the values
+ * land on the same matrix positions as the keycodes.
+ */
+enum sim_finger
+{
+  F__ = 0, // no key at this matrix position
+  F_LP,
+  F_LR,
+  F_LM,
+  F_LI,
+  F_LT,
+  F_RT,
+  F_RI,
+  F_RM,
+  F_RR,
+  F_RP,
+};
+
+/* User hooks */
+bool process_record_user(uint16_t keycode, keyrecord_t *record);
+void matrix_init_user(void);
+void matrix_scan_user(void);
+
+#endif
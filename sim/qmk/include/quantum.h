@@ -0,0 +1,12 @@
+#ifndef SIM_QUANTUM_H
+#define SIM_QUANTUM_H
+
+#include "qmk_sim.h"
+
+// Keymap builds know their board, as QMK's quantum.h does
+#ifdef QMK_KEYBOARD_H
+#include QMK_KEYBOARD_H
+#include "matrix.h"
+#endif
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef SIM_VERSION_H
+#define SIM_VERSION_H
+
+#ifndef QMK_KEYBOARD
+#define QMK_KEYBOARD "sim"
+#endif
+#ifndef QMK_KEYMAP
+#define QMK_KEYMAP "heartrobotninja"
+#endif
+#define QMK_VERSION "sim"
+#define QMK_BUILDDATE "sim"
+
+#endif
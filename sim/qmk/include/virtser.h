@@ -0,0 +1,9 @@
+#ifndef SIM_VIRTSER_H
+#define SIM_VIRTSER_H
+
+#include "qmk_sim.h"
+
+// Every byte goes to the hook set with sim_board.set_serial_hook
+void virtser_send(const uint8_t byte);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef SIM_WAIT_H
+#define SIM_WAIT_H
+
+#include "qmk_sim.h"
+
+#endif
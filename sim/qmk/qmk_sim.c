@@ -0,0 +1,615 @@
+#include <avr/eeprom.h>
+#include "eeconfig.h"
+#include "sim.h"
+#include "sim_runtime.h"
+#include "virtser.h"
+
+#ifndef ONESHOT_TIMEOUT
+#define ONESHOT_TIMEOUT 0
+#endif
+
+#define WEAK __attribute__((weak))
+
+/* Clock */
+uint64_t sim_clock_us;
+
+uint16_t timer_read(void)
+{
+  return (uint16_t)(sim_clock_us / 1000);
+}
+
+uint32_t timer_read32(void)
+{
+  return (uint32_t)(sim_clock_us / 1000);
+}
+
+uint16_t timer_elapsed(uint16_t last)
+{
+  return (uint16_t)(timer_read() - last);
+}
+
+uint32_t timer_elapsed32(uint32_t last)
+{
+  return timer_read32() - last;
+}
+
+void wait_ms(uint16_t ms)
+{
+  sim_clock_us += (uint64_t)ms * 1000;
+}
+
+void wait_us(uint16_t us)
+{
+  sim_clock_us += us;
+}
+
+uint64_t sim_now_us(void)
+{
+  return sim_clock_us;
+}
+
+/* Layers */
+uint32_t layer_state;
+uint32_t default_layer_state;
+keymap_config_t keymap_config;
+
+static void clear_keyboard_but_mods(void);
+
+static void layer_state_set(uint32_t state)
+{
+  layer_state = state;
+  // TMK releases held keys on every layer change to avoid stuck keys
+  clear_keyboard_but_mods();
+}
+
+void default_layer_set(uint32_t state)
+{
+  default_layer_state = state;
+  clear_keyboard_but_mods();
+}
+
+void layer_clear(void)
+{
+  layer_state_set(0);
+}
+
+void layer_move(uint8_t layer)
+{
+  layer_state_set(1UL << layer);
+}
+
+void layer_on(uint8_t layer)
+{
+  layer_state_set(layer_state | (1UL << layer));
+}
+
+void layer_off(uint8_t layer)
+{
+  layer_state_set(layer_state & ~(1UL << layer));
+}
+
+void layer_invert(uint8_t layer)
+{
+  layer_state_set(layer_state ^ (1UL << layer));
+}
+
+void update_tri_layer(uint8_t layer1, uint8_t layer2, uint8_t layer3)
+{
+  if ((layer_state & (1UL << layer1)) && (layer_state & (1UL << layer2)))
+  {
+    layer_on(layer3);
+  }
+  else
+  {
+    layer_off(layer3);
+  }
+}
+
+uint8_t biton32(uint32_t bits)
+{
+  uint8_t n = 0;
+  while (bits >>= 1)
+  {
+    n++;
+  }
+  return n;
+}
+
+/* Reports */
+static report_keyboard_t report;
+report_keyboard_t *keyboard_report = &report;
+
+static uint8_t real_mods;
+static uint8_t weak_mods;
+static uint8_t oneshot_mods;
+static uint16_t oneshot_time;
+
+sim_report_fn sim_report_hook;
+void *sim_report_ctx;
+uint64_t sim_report_count;
+
+void sim_set_report_hook(sim_report_fn fn, void *ctx)
+{
+  sim_report_hook = fn;
+  sim_report_ctx = ctx;
+}
+
+sim_mouse_fn sim_mouse_hook;
+void *sim_mouse_ctx;
+
+void sim_set_mouse_hook(sim_mouse_fn fn, void *ctx)
+{
+  sim_mouse_hook = fn;
+  sim_mouse_ctx = ctx;
+}
+
+void host_mouse_send(report_mouse_t *report)
+{
+  if (sim_mouse_hook)
+  {
+    sim_mouse_hook(sim_mouse_ctx, report);
+  }
+}
+
+static uint8_t host_leds;
+
+uint8_t host_keyboard_leds(void)
+{
+  return host_leds;
+}
+
+void sim_set_leds(uint8_t leds)
+{
+  host_leds = leds;
+}
+
+sim_serial_fn sim_serial_hook;
+void *sim_serial_ctx;
+
+void sim_set_serial_hook(sim_serial_fn fn, void *ctx)
+{
+  sim_serial_hook = fn;
+  sim_serial_ctx = ctx;
+}
+
+void virtser_send(const uint8_t byte)
+{
+  if (sim_serial_hook)
+  {
+    sim_serial_hook(sim_serial_ctx, byte);
+  }
+}
+
+static bool has_anykey(void)
+{
+  for (uint8_t i = 0; i < sizeof(report.bits); i++)
+  {
+    if (report.bits[i])
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void send_keyboard_report(void)
+{
+  report.mods = real_mods | weak_mods;
+  if (oneshot_mods)
+  {
+    if (ONESHOT_TIMEOUT > 0 && has_oneshot_mods_timed_out())
+    {
+      clear_oneshot_mods();
+    }
+    report.mods |= oneshot_mods;
+    if (has_anykey())
+    {
+      clear_oneshot_mods();
+    }
+  }
+  sim_report_count++;
+  if (sim_report_hook)
+  {
+    sim_report_hook(sim_report_ctx, &report);
+  }
+}
+
+/* System and consumer usages share the NKRO bitmap; their TMK codes sit in
+ * a reserved part of the keyboard usage page, so nothing collides.
+ */
+static bool is_reportable(uint8_t code)
+{
+  return IS_KEY(code) || IS_SYSTEM(code) || IS_CONSUMER(code);
+}
+
+void add_key(uint8_t code)
+{
+  report.bits[code >> 3] |= 1 << (code & 7);
+}
+
+void del_key(uint8_t code)
+{
+  report.bits[code >> 3] &= ~(1 << (code & 7));
+}
+
+void register_code(uint8_t code)
+{
+  if (code == KC_NO)
+  {
+    return;
+  }
+  if (is_reportable(code))
+  {
+    add_key(code);
+    send_keyboard_report();
+  }
+  else if (IS_MOD(code))
+  {
+    add_mods(MOD_BIT(code));
+    send_keyboard_report();
+  }
+}
+
+void unregister_code(uint8_t code)
+{
+  if (code == KC_NO)
+  {
+    return;
+  }
+  if (is_reportable(code))
+  {
+    del_key(code);
+    send_keyboard_report();
+  }
+  else if (IS_MOD(code))
+  {
+    del_mods(MOD_BIT(code));
+    send_keyboard_report();
+  }
+}
+
+static uint8_t keycode_mods(uint16_t code)
+{
+  uint8_t mods = 0;
+  if (code & QK_LCTL)
+    mods |= MOD_BIT(KC_LCTL);
+  if (code & QK_LSFT)
+    mods |= MOD_BIT(KC_LSFT);
+  if (code & QK_LALT)
+    mods |= MOD_BIT(KC_LALT);
+  if (code & QK_LGUI)
+    mods |= MOD_BIT(KC_LGUI);
+  return (code & QK_RMODS_MIN) ? mods << 4 : mods;
+}
+
+void register_code16(uint16_t code)
+{
+  if (code >= QK_MODS && code <= QK_MODS_MAX)
+  {
+    add_weak_mods(keycode_mods(code));
+    send_keyboard_report();
+  }
+  register_code(code);
+}
+
+void unregister_code16(uint16_t code)
+{
+  unregister_code(code);
+  if (code >= QK_MODS && code <= QK_MODS_MAX)
+  {
+    del_weak_mods(keycode_mods(code));
+    send_keyboard_report();
+  }
+}
+
+void add_mods(uint8_t mods)
+{
+  real_mods |= mods;
+}
+
+void del_mods(uint8_t mods)
+{
+  real_mods &= ~mods;
+}
+
+void set_mods(uint8_t mods)
+{
+  real_mods = mods;
+}
+
+void clear_mods(void)
+{
+  real_mods = 0;
+}
+
+uint8_t get_mods(void)
+{
+  return real_mods;
+}
+
+void add_weak_mods(uint8_t mods)
+{
+  weak_mods |= mods;
+}
+
+void del_weak_mods(uint8_t mods)
+{
+  weak_mods &= ~mods;
+}
+
+void clear_weak_mods(void)
+{
+  weak_mods = 0;
+}
+
+static void clear_keyboard_but_mods(void)
+{
+  if (has_anykey())
+  {
+    memset(report.bits, 0, sizeof(report.bits));
+    send_keyboard_report();
+  }
+}
+
+void clear_keyboard(void)
+{
+  clear_mods();
+  clear_weak_mods();
+  memset(report.bits, 0, sizeof(report.bits));
+  send_keyboard_report();
+}
+
+void set_oneshot_mods(uint8_t mods)
+{
+  oneshot_mods = mods;
+  oneshot_time = timer_read();
+}
+
+void clear_oneshot_mods(void)
+{
+  oneshot_mods = 0;
+  oneshot_time = 0;
+}
+
+uint8_t get_oneshot_mods(void)
+{
+  return oneshot_mods;
+}
+
+bool has_oneshot_mods_timed_out(void)
+{
+  return ONESHOT_TIMEOUT > 0 && timer_elapsed(oneshot_time) >= ONESHOT_TIMEOUT;
+}
+
+void send_string(const char *str)
+{
+  for (; *str; str++)
+  {
+    uint16_t keycode = sim_char_keycode(*str);
+    if (keycode & QK_LSFT)
+    {
+      register_code(KC_LSFT);
+    }
+    register_code(keycode);
+    unregister_code(keycode);
+    if (keycode & QK_LSFT)
+    {
+      unregister_code(KC_LSFT);
+    }
+  }
+}
+
+/* EEPROM */
+static uint8_t eeprom[E2END + 1];
+static uint64_t eeprom_ready_us;
+uint32_t sim_eeprom_writes;
+uint64_t sim_eeprom_stall_us;
+
+void sim_eeprom_erase(void)
+{
+  memset(eeprom, 0xFF, sizeof(eeprom));
+}
+
+bool eeprom_is_ready(void)
+{
+  return sim_clock_us >= eeprom_ready_us;
+}
+
+// Like avr-libc, every access first spins until a running write is done
+static void eeprom_wait(void)
+{
+  if (sim_clock_us < eeprom_ready_us)
+  {
+    sim_eeprom_stall_us += eeprom_ready_us - sim_clock_us;
+    sim_clock_us = eeprom_ready_us;
+  }
+}
+
+uint8_t eeprom_read_byte(const uint8_t *addr)
+{
+  eeprom_wait();
+  return eeprom[(uintptr_t)addr & E2END];
+}
+
+uint16_t eeprom_read_word(const uint16_t *addr)
+{
+  const uint8_t *p = (const uint8_t *)addr;
+  return eeprom_read_byte(p) | (uint16_t)eeprom_read_byte(p + 1) << 8;
+}
+
+uint32_t eeprom_read_dword(const uint32_t *addr)
+{
+  const uint16_t *p = (const uint16_t *)addr;
+  return eeprom_read_word(p) | (uint32_t)eeprom_read_word(p + 1) << 16;
+}
+
+void eeprom_write_byte(uint8_t *addr, uint8_t value)
+{
+  eeprom_wait();
+  eeprom[(uintptr_t)addr & E2END] = value;
+  eeprom_ready_us = sim_clock_us + EEPROM_WRITE_US;
+  sim_eeprom_writes++;
+}
+
+void eeprom_write_word(uint16_t *addr, uint16_t value)
+{
+  uint8_t *p = (uint8_t *)addr;
+  eeprom_write_byte(p, value);
+  eeprom_write_byte(p + 1, value >> 8);
+}
+
+void eeprom_write_dword(uint32_t *addr, uint32_t value)
+{
+  uint16_t *p = (uint16_t *)addr;
+  eeprom_write_word(p, value);
+  eeprom_write_word(p + 1, value >> 16);
+}
+
+void eeprom_update_byte(uint8_t *addr, uint8_t value)
+{
+  if (eeprom_read_byte(addr) != value)
+  {
+    eeprom_write_byte(addr, value);
+  }
+}
+
+void eeprom_update_word(uint16_t *addr, uint16_t value)
+{
+  uint8_t *p = (uint8_t *)addr;
+  eeprom_update_byte(p, value);
+  eeprom_update_byte(p + 1, value >> 8);
+}
+
+void eeprom_update_dword(uint32_t *addr, uint32_t value)
+{
+  uint16_t *p = (uint16_t *)addr;
+  eeprom_update_word(p, value);
+  eeprom_update_word(p + 1, value >> 16);
+}
+
+bool eeconfig_is_enabled(void)
+{
+  return eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER;
+}
+
+void eeconfig_init(void)
+{
+  eeprom_write_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+  eeprom_write_byte(EECONFIG_DEBUG, 0);
+  eeprom_write_byte(EECONFIG_DEFAULT_LAYER, 0);
+  eeprom_write_byte(EECONFIG_KEYMAP, 0);
+  eeprom_write_byte(EECONFIG_MOUSEKEY_ACCEL, 0);
+#ifdef BACKLIGHT_ENABLE
+  eeprom_write_byte(EECONFIG_BACKLIGHT, 0);
+#endif
+#ifdef AUDIO_ENABLE
+  eeprom_write_byte(EECONFIG_AUDIO, 0xFF);
+#endif
+#ifdef RGBLIGHT_ENABLE
+  eeprom_write_dword(EECONFIG_RGBLIGHT, 0);
+#endif
+}
+
+uint8_t eeconfig_read_default_layer(void)
+{
+  return eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+}
+
+void eeconfig_update_default_layer(uint8_t val)
+{
+  eeprom_write_byte(EECONFIG_DEFAULT_LAYER, val);
+}
+
+/* Tap dance */
+#ifdef TAP_DANCE_ENABLE
+void qk_tap_dance_pair_finished(qk_tap_dance_state_t *state, void *user_data)
+{
+  qk_tap_dance_pair_t *pair = (qk_tap_dance_pair_t *)user_data;
+
+  if (state->count == 1)
+  {
+    register_code16(pair->kc1);
+  }
+  else if (state->count == 2)
+  {
+    register_code16(pair->kc2);
+  }
+}
+
+void qk_tap_dance_pair_reset(qk_tap_dance_state_t *state, void *user_data)
+{
+  qk_tap_dance_pair_t *pair = (qk_tap_dance_pair_t *)user_data;
+
+  if (state->count == 1)
+  {
+    unregister_code16(pair->kc1);
+  }
+  else if (state->count == 2)
+  {
+    unregister_code16(pair->kc2);
+  }
+}
+
+void reset_tap_dance(qk_tap_dance_state_t *state)
+{
+  if (state->pressed)
+  {
+    return;
+  }
+  qk_tap_dance_action_t *action = &tap_dance_actions[state->keycode - QK_TAP_DANCE];
+  if (action->fn.on_reset)
+  {
+    action->fn.on_reset(state, action->user_data);
+  }
+  state->count = 0;
+  state->interrupted = false;
+  state->finished = false;
+}
+#endif
+
+/* Leader */
+bool leading;
+uint16_t leader_time;
+uint16_t leader_sequence[5];
+uint8_t leader_sequence_size;
+
+WEAK void leader_start(void) {}
+WEAK void leader_end(void) {}
+
+/* RGB underglow and LEDs keep no state the tools look at */
+void rgblight_init(void) {}
+void rgblight_enable(void) {}
+void rgblight_toggle(void) {}
+void rgblight_mode(uint8_t mode) { (void)mode; }
+void rgblight_step(void) {}
+void rgblight_setrgb(uint8_t r, uint8_t g, uint8_t b) { (void)r, (void)g, (void)b; }
+void rgblight_effect_knight(uint8_t interval) { (void)interval; }
+
+void ergodox_led_all_on(void) {}
+void ergodox_led_all_off(void) {}
+void ergodox_led_all_set(uint8_t n) { (void)n; }
+void ergodox_right_led_1_on(void) {}
+void ergodox_right_led_1_off(void) {}
+void ergodox_right_led_1_set(uint8_t n) { (void)n; }
+void ergodox_right_led_2_on(void) {}
+void ergodox_right_led_2_off(void) {}
+void ergodox_right_led_2_set(uint8_t n) { (void)n; }
+void ergodox_right_led_3_on(void) {}
+void ergodox_right_led_3_off(void) {}
+void ergodox_right_led_3_set(uint8_t n) { (void)n; }
+
+/* User hooks a keymap may leave out */
+WEAK bool process_record_user(uint16_t keycode, keyrecord_t *record)
+{
+  (void)keycode, (void)record;
+  return true;
+}
+
+WEAK void matrix_init_user(void) {}
+WEAK void matrix_scan_user(void) {}
+
+WEAK const macro_t *action_get_macro(keyrecord_t *record, uint8_t id, uint8_t opt)
+{
+  (void)record, (void)id, (void)opt;
+  return MACRO_NONE;
+}
@@ -0,0 +1,188 @@
+/* Compiles a board's keymap.c unchanged and describes it to the tools */
+
+#include KEYMAP_C
+#include "sim_runtime.h"
+
+#define SIM_EXPORT __attribute__((visibility("default")))
+
+// Optional keymap modules; a weak reference is NULL when the board lacks one
+__attribute__((weak)) void uni_send(uint8_t method, uint32_t code_point);
+__attribute__((weak)) void snippet_send(uint8_t n);
+__attribute__((weak)) bool process_mouse_keys(uint16_t keycode, keyrecord_t *record);
+__attribute__((weak)) bool process_steno_keys(uint16_t keycode, keyrecord_t *record);
+
+// What each module's scan task still has to do
+__attribute__((weak)) void eeq_task(void);
+__attribute__((weak)) bool eeq_pending(void);
+__attribute__((weak)) void home_row_task(void);
+__attribute__((weak)) uint16_t home_row_due_in(void);
+__attribute__((weak)) bool home_row_pending(void);
+__attribute__((weak)) void mouse_keys_task(void);
+__attribute__((weak)) uint16_t mouse_keys_due_in(void);
+__attribute__((weak)) bool mouse_keys_pending(void);
+__attribute__((weak)) void steno_task(void);
+__attribute__((weak)) bool steno_pending(void);
+__attribute__((weak)) void snippet_task(void);
+__attribute__((weak)) bool snippet_pending(void);
+__attribute__((weak)) void journal_task(void);
+__attribute__((weak)) bool journal_pending(void);
+__attribute__((weak)) void sched_task(void);
+__attribute__((weak)) uint16_t sched_due_in(void);
+
+// A split keymap's own matrix merging the halves, see split_link.h
+__attribute__((weak)) void split_link_init(bool left_is_master, uint8_t latency);
+__attribute__((weak)) void split_link_scan(const matrix_row_t *local, const matrix_row_t *remote,
+                                           matrix_row_t *matrix);
+__attribute__((weak)) bool split_link_pending(void);
+
+#ifndef SIM_SPLIT_ROWS
+#define SIM_SPLIT_ROWS 0
+#endif
+
+static const uint8_t sim_fingers[MATRIX_ROWS][MATRIX_COLS] = SIM_FINGERS;
+
+static bool sim_tap_dance_pair(uint8_t n, uint16_t *kc1, uint16_t *kc2)
+{
+#ifdef TAP_DANCE_ENABLE
+  qk_tap_dance_action_t *action = &tap_dance_actions[n];
+  if (action->fn.on_dance_finished == qk_tap_dance_pair_finished)
+  {
+    qk_tap_dance_pair_t *pair = action->user_data;
+    *kc1 = pair->kc1;
+    *kc2 = pair->kc2;
+    return true;
+  }
+#endif
+  (void)n, (void)kc1, (void)kc2;
+  return false;
+}
+
+/* A module whose task is linked in but can't say what it has left, as in
+ * builds of older revisions, keeps the board scanning. Modules that only
+ * wait on a timer say when it's due instead; older builds of those only
+ * say whether they're waiting.
+ */
+#define SIM_TASK_IDLE(task, pending) (!(task) || ((pending) && !(pending)()))
+#define SIM_TASK_TIMED(task, due_in, pending) ((due_in) || SIM_TASK_IDLE(task, pending))
+#define SIM_DUE_IN(due_in) ((due_in) ? (due_in)() : 0xFFFF)
+
+// Longest skip, well inside the 16-bit timers keymaps compare against
+#define SIM_SKIP_MAX 0x4000
+
+// Nothing for a scan to do now but run the keymap's and the runtime's timers
+static bool sim_board_quiet(void)
+{
+  return sim_quiet() && SIM_TASK_IDLE(eeq_task, eeq_pending) &&
+         SIM_TASK_TIMED(home_row_task, home_row_due_in, home_row_pending) &&
+         SIM_TASK_TIMED(mouse_keys_task, mouse_keys_due_in, mouse_keys_pending) &&
+         SIM_TASK_IDLE(steno_task, steno_pending) && SIM_TASK_IDLE(snippet_task, snippet_pending) &&
+         SIM_TASK_IDLE(journal_task, journal_pending) && (!sched_task || sched_due_in);
+}
+
+/* Milliseconds until a tap key, tap dance or held back home row key is
+ * decided or moving mouse keys report, 0xFFFF when nothing waits
+ */
+static uint16_t sim_board_due_in(void)
+{
+  uint16_t due = sim_due_in();
+  uint16_t home_row = SIM_DUE_IN(home_row_due_in);
+  uint16_t mouse = SIM_DUE_IN(mouse_keys_due_in);
+  due = home_row < due ? home_row : due;
+  return mouse < due ? mouse : due;
+}
+
+static bool sim_board_idle(void)
+{
+  return sim_board_quiet() && sim_board_due_in() == 0xFFFF;
+}
+
+static uint32_t sim_idle_scans(void)
+{
+  if (!sim_board_quiet())
+  {
+    return 0;
+  }
+  uint16_t due = sim_board_due_in();
+  if (sched_task)
+  {
+    uint16_t timer = sched_due_in();
+    due = timer < due ? timer : due;
+  }
+  // Scan n after this one runs a timer due in n ms
+  return due == 0 ? 0 : due - 1 < SIM_SKIP_MAX ? due - 1 : SIM_SKIP_MAX;
+}
+
+/* The runtime's side of split_link.c, in its 32-bit rows. Stands in for
+ * the keymap's matrix.c, which reads the pins and the serial buffer and
+ * hands the rows to split_link_scan() the same way.
+ */
+bool sim_merge_init(bool left_is_master, uint8_t latency)
+{
+  if (!split_link_init)
+  {
+    return false;
+  }
+  split_link_init(left_is_master, latency);
+  return true;
+}
+
+void sim_merge_scan(const uint32_t *local, const uint32_t *remote, uint32_t *matrix)
+{
+  matrix_row_t l[SIM_SPLIT_ROWS + 1] = {0}, r[SIM_SPLIT_ROWS + 1] = {0}, m[MATRIX_ROWS];
+  for (uint8_t i = 0; i < SIM_SPLIT_ROWS; i++)
+  {
+    l[i] = local[i];
+    r[i] = remote[i];
+  }
+  for (uint8_t i = 0; i < MATRIX_ROWS; i++)
+  {
+    m[i] = matrix[i];
+  }
+  split_link_scan(l, r, m);
+  for (uint8_t i = 0; i < MATRIX_ROWS; i++)
+  {
+    matrix[i] = m[i];
+  }
+}
+
+bool sim_merge_pending(void)
+{
+  return split_link_pending && split_link_pending();
+}
+
+SIM_EXPORT const sim_board_t sim_board = {
+    .keyboard = QMK_KEYBOARD,
+    .rows = MATRIX_ROWS,
+    .cols = MATRIX_COLS,
+    .layers = sizeof(keymaps) / sizeof(keymaps[0]),
+    .split_rows = SIM_SPLIT_ROWS,
+    .keymaps = &keymaps[0][0][0],
+    .fingers = &sim_fingers[0][0],
+#ifdef TAP_DANCE_ENABLE
+    .tap_dance_count = sizeof(tap_dance_actions) / sizeof(tap_dance_actions[0]),
+#endif
+    .tapping_term = TAPPING_TERM,
+#ifdef ONESHOT_TIMEOUT
+    .oneshot_timeout = ONESHOT_TIMEOUT,
+#endif
+    .leader_timeout = LEADER_TIMEOUT,
+    .tap_dance_pair = sim_tap_dance_pair,
+    .init = sim_init,
+    .key = sim_key,
+    .scan = sim_scan,
+    .idle = sim_board_idle,
+    .idle_scans = sim_idle_scans,
+    .skip = sim_skip,
+    .set_report_hook = sim_set_report_hook,
+    .set_mouse_hook = sim_set_mouse_hook,
+    .set_serial_hook = sim_set_serial_hook,
+    .layer_on = layer_on,
+    .set_event_hook = sim_set_event_hook,
+    .set_link = sim_set_link,
+    .now_us = sim_now_us,
+    .set_leds = sim_set_leds,
+    .unicode_send = uni_send,
+    .snippet_send = snippet_send,
+    .mouse_keys = process_mouse_keys,
+    .steno_keys = process_steno_keys,
+};
@@ -0,0 +1,54 @@
+#ifndef SIM_RUNTIME_H
+#define SIM_RUNTIME_H
+
+/* State shared between the runtime files inside one keymap build */
+
+#include "sim.h"
+
+extern const sim_board_t sim_board;
+
+extern uint64_t sim_clock_us;
+
+extern sim_report_fn sim_report_hook;
+extern void *sim_report_ctx;
+extern uint64_t sim_report_count;
+
+extern sim_mouse_fn sim_mouse_hook;
+extern void *sim_mouse_ctx;
+
+extern sim_serial_fn sim_serial_hook;
+extern void *sim_serial_ctx;
+
+extern uint32_t sim_eeprom_writes;
+extern uint64_t sim_eeprom_stall_us;
+extern uint32_t sim_resets;
+
+void sim_eeprom_erase(void);
+void sim_set_report_hook(sim_report_fn fn, void *ctx);
+void sim_set_mouse_hook(sim_mouse_fn fn, void *ctx);
+void sim_set_serial_hook(sim_serial_fn fn, void *ctx);
+void sim_set_leds(uint8_t leds);
+uint64_t sim_now_us(void);
+
+/* sim_keymap.c: the keymap's split_link.c, rows as the runtime keeps them.
+ * sim_merge_init() is false when the keymap has none.
+ */
+bool sim_merge_init(bool left_is_master, uint8_t latency);
+void sim_merge_scan(const uint32_t *local, const uint32_t *remote, uint32_t *matrix);
+bool sim_merge_pending(void);
+
+/* action.c */
+extern sim_event_fn sim_event_hook;
+extern void *sim_event_ctx;
+
+void sim_init(void);
+void sim_key(uint8_t row, uint8_t col, bool pressed);
+void sim_scan(void);
+bool sim_quiet(void);
+uint16_t sim_due_in(void);
+bool sim_idle(void);
+void sim_skip(uint32_t scans);
+void sim_set_event_hook(sim_event_fn fn, void *ctx);
+bool sim_set_link(bool right_is_master, uint8_t delay, bool merged);
+
+#endif
@@ -0,0 +1,559 @@
+/* Differential replay of two keymap builds
+ *
+ *   replay [-j shards] [-n events] [-s seed] [-g mean_gap] [-t tolerance]
+ *          [-r events.txt] [-w events.txt] [-S] old.so new.so
+ *
+ * Feeds the same key event stream to both builds scan by scan and compares
+ * the keyboard reports they send. The first report that differs in content,
+ * or that one build sends more than -t scans before the other, is printed
+ * with the events leading up to it and the run exits 1.
+ *
+ * While neither build has anything for a scan to act on, the clock jumps
+ * straight to the next event or to the next deadline either build waits
+ * on: a keymap timer, tap key, tap dance, held back home row key or mouse
+ * report. Only the scans with work in them are run. -S scans through every
+ * gap; the digest of the old build's reports and the scans they came on is
+ * the same either way.
+ *
+ * Streams are random (one seed per shard, generated in batches) or read
+ * from a recording with -r. Shards run in forked processes, one per core by
+ * default, so each gets private copies of both keymaps' globals.
+ *
+ * Event file format, one per line: <scans since previous event> <row> <col> <d|u>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+
+#define BATCH 4096
+#define QUEUE 1024
+#define HISTORY 16
+#define MAX_POS 256
+#define MAX_HELD 4
+#define TARGET_EVENTS_PER_S 10e6 // tens of millions, per the replay's brief
+
+typedef struct
+{
+  uint32_t gap; // scans to run before this event
+  uint8_t row;
+  uint8_t col;
+  bool pressed;
+} event_t;
+
+typedef struct
+{
+  uint64_t scan;
+  report_keyboard_t report;
+} entry_t;
+
+typedef struct
+{
+  entry_t q[QUEUE];
+  unsigned head;
+  unsigned count;
+  uint64_t total;
+  bool report_digest;
+} side_t;
+
+typedef struct
+{
+  uint64_t events;
+  uint64_t scans;
+  uint64_t reports;
+  uint64_t skipped; // scans the clock was moved over
+  uint64_t digest;
+  double seconds;
+  bool diverged;
+} result_t;
+
+static const sim_board_t *old_board;
+static const sim_board_t *new_board;
+static uint64_t scan_no;
+static unsigned tolerance;
+static bool skip_idle = true;
+static uint64_t digest = 0xCBF29CE484222325ULL;
+
+/* Report capture */
+
+static void capture(void *ctx, const report_keyboard_t *report)
+{
+  side_t *side = ctx;
+  if (side->report_digest)
+  {
+    const uint8_t *p = (const uint8_t *)report;
+    digest = (digest ^ scan_no) * 0x100000001B3ULL;
+    for (size_t i = 0; i < sizeof(*report); i++)
+    {
+      digest = (digest ^ p[i]) * 0x100000001B3ULL;
+    }
+  }
+  if (side->count == QUEUE)
+  {
+    // The other side is far behind; drop the oldest, divergence is certain
+    side->head = (side->head + 1) % QUEUE;
+    side->count--;
+  }
+  entry_t *e = &side->q[(side->head + side->count) % QUEUE];
+  e->scan = scan_no;
+  e->report = *report;
+  side->count++;
+  side->total++;
+}
+
+static void format_report(const report_keyboard_t *r, char *buf, size_t len)
+{
+  static const char *const mod_names[] = {"LCTL", "LSFT", "LALT", "LGUI",
+                                          "RCTL", "RSFT", "RALT", "RGUI"};
+  size_t n = snprintf(buf, len, "[");
+  for (int i = 0; i < 8; i++)
+  {
+    if (r->mods & (1 << i))
+    {
+      n += snprintf(buf + n, len - n, " %s", mod_names[i]);
+    }
+  }
+  for (int code = 0; code < 256 && n < len; code++)
+  {
+    if (r->bits[code >> 3] & (1 << (code & 7)))
+    {
+      char tmp[32];
+      n += snprintf(buf + n, len - n, " %s", sim_keycode_name(code, tmp, sizeof(tmp)));
+    }
+  }
+  if (n < len)
+  {
+    snprintf(buf + n, len - n, " ]");
+  }
+}
+
+/* Event streams */
+
+typedef struct
+{
+  uint64_t rng;
+  double mean_gap;
+  uint16_t npos;
+  uint8_t pos[MAX_POS][2];
+  uint8_t held[MAX_HELD];
+  uint8_t nheld;
+  int last_released;
+  FILE *in;
+} source_t;
+
+static uint64_t next_rand(source_t *s)
+{
+  uint64_t x = s->rng;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return s->rng = x;
+}
+
+static uint32_t random_gap(source_t *s)
+{
+  uint32_t r = next_rand(s) % 1000;
+  if (r < 20)
+  {
+    // long enough for the leader and oneshot timeouts
+    return 300 + next_rand(s) % 1500;
+  }
+  if (r < 120)
+  {
+    // around TAPPING_TERM
+    return 100 + next_rand(s) % 250;
+  }
+  return next_rand(s) % (uint32_t)(2 * s->mean_gap + 1);
+}
+
+static void random_event(source_t *s, event_t *e)
+{
+  e->gap = random_gap(s);
+  bool press = s->nheld == 0 || (s->nheld < MAX_HELD && next_rand(s) % 100 < 50);
+  if (press)
+  {
+    int p;
+    if (s->last_released >= 0 && next_rand(s) % 100 < 20)
+    {
+      // repeat taps drive tap dance, TT and oneshot counts
+      p = s->last_released;
+    }
+    else
+    {
+      p = next_rand(s) % s->npos;
+    }
+    for (int i = 0; i < s->nheld; i++)
+    {
+      if (s->held[i] == p)
+      {
+        p = -1;
+        break;
+      }
+    }
+    if (p >= 0)
+    {
+      s->held[s->nheld++] = p;
+      e->row = s->pos[p][0];
+      e->col = s->pos[p][1];
+      e->pressed = true;
+      return;
+    }
+  }
+  int i = next_rand(s) % s->nheld;
+  int p = s->held[i];
+  s->held[i] = s->held[--s->nheld];
+  s->last_released = p;
+  e->row = s->pos[p][0];
+  e->col = s->pos[p][1];
+  e->pressed = false;
+}
+
+static int fill_batch(source_t *s, event_t *batch, uint64_t remaining)
+{
+  int n = remaining < BATCH ? remaining : BATCH;
+  if (s->in)
+  {
+    int i;
+    for (i = 0; i < n; i++)
+    {
+      unsigned gap, row, col;
+      char dir;
+      if (fscanf(s->in, "%u %u %u %c", &gap, &row, &col, &dir) != 4)
+      {
+        break;
+      }
+      batch[i] = (event_t){gap, row, col, dir == 'd'};
+    }
+    return i;
+  }
+  for (int i = 0; i < n; i++)
+  {
+    random_event(s, &batch[i]);
+  }
+  return n;
+}
+
+/* Comparison */
+
+static void print_divergence(int shard, uint64_t seed, uint64_t event_no, const event_t *history,
+                             int nhistory, const entry_t *a, const entry_t *b)
+{
+  char buf[512], tmp[32];
+
+  printf("shard %d (seed %llu): divergence at event %llu, scan %llu\n", shard,
+         (unsigned long long)seed, (unsigned long long)event_no, (unsigned long long)scan_no);
+  printf("  last events:\n");
+  for (int i = 0; i < nhistory; i++)
+  {
+    const event_t *e = &history[i];
+    uint16_t base = SIM_KEYMAP_AT(old_board, 0, e->row, e->col);
+    printf("    +%-5u [%d][%d] %-12s %s\n", e->gap, e->row, e->col,
+           sim_keycode_name(base, tmp, sizeof(tmp)), e->pressed ? "down" : "up");
+  }
+  if (a)
+  {
+    format_report(&a->report, buf, sizeof(buf));
+    printf("  old @ scan %-8llu %s\n", (unsigned long long)a->scan, buf);
+  }
+  else
+  {
+    printf("  old: no report\n");
+  }
+  if (b)
+  {
+    format_report(&b->report, buf, sizeof(buf));
+    printf("  new @ scan %-8llu %s\n", (unsigned long long)b->scan, buf);
+  }
+  else
+  {
+    printf("  new: no report\n");
+  }
+}
+
+// Returns true while the two report streams agree
+static bool compare(side_t *a, side_t *b, const entry_t **ea, const entry_t **eb)
+{
+  while (a->count && b->count)
+  {
+    entry_t *x = &a->q[a->head];
+    entry_t *y = &b->q[b->head];
+    uint64_t skew = x->scan > y->scan ? x->scan - y->scan : y->scan - x->scan;
+    if (memcmp(&x->report, &y->report, sizeof(report_keyboard_t)) || skew > tolerance)
+    {
+      *ea = x;
+      *eb = y;
+      return false;
+    }
+    a->head = (a->head + 1) % QUEUE;
+    a->count--;
+    b->head = (b->head + 1) % QUEUE;
+    b->count--;
+  }
+  side_t *ahead = a->count ? a : b->count ? b : NULL;
+  if (ahead && scan_no - ahead->q[ahead->head].scan > tolerance)
+  {
+    *ea = ahead == a ? &a->q[a->head] : NULL;
+    *eb = ahead == b ? &b->q[b->head] : NULL;
+    return false;
+  }
+  return true;
+}
+
+// Scans both builds can skip, at most limit
+static uint32_t idle_scans(uint32_t limit)
+{
+  uint32_t a = old_board->idle_scans();
+  limit = a < limit ? a : limit;
+  if (!limit)
+  {
+    return 0;
+  }
+  uint32_t b = new_board->idle_scans();
+  return b < limit ? b : limit;
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static result_t run_shard(int shard, uint64_t seed, uint64_t nevents, double mean_gap,
+                          FILE *in, FILE *out)
+{
+  static side_t old_side, new_side;
+  static event_t batch[BATCH];
+  event_t history[HISTORY];
+  result_t res = {0};
+  source_t src = {.rng = 0x9E3779B97F4A7C15ULL * (seed + 1), .mean_gap = mean_gap,
+                  .last_released = -1, .in = in};
+
+  for (int r = 0; r < old_board->rows; r++)
+  {
+    for (int c = 0; c < old_board->cols && src.npos < MAX_POS; c++)
+    {
+      if (old_board->fingers[r * old_board->cols + c])
+      {
+        src.pos[src.npos][0] = r;
+        src.pos[src.npos][1] = c;
+        src.npos++;
+      }
+    }
+  }
+
+  old_side.report_digest = true;
+  old_board->set_report_hook(capture, &old_side);
+  new_board->set_report_hook(capture, &new_side);
+  old_board->init();
+  new_board->init();
+
+  double t0 = now();
+  uint64_t done = 0;
+  int n;
+  while (done < nevents && (n = fill_batch(&src, batch, nevents - done)) > 0)
+  {
+    for (int i = 0; i < n; i++, done++)
+    {
+      const event_t *e = &batch[i];
+      const entry_t *ea, *eb;
+
+      history[done % HISTORY] = *e;
+      if (out)
+      {
+        fprintf(out, "%u %u %u %c\n", e->gap, e->row, e->col, e->pressed ? 'd' : 'u');
+      }
+      for (uint32_t g = 0; g < e->gap;)
+      {
+        uint32_t n = skip_idle ? idle_scans(e->gap - g) : 0;
+        if (n)
+        {
+          old_board->skip(n);
+          new_board->skip(n);
+          scan_no += n;
+          res.skipped += n;
+          g += n;
+          if (g == e->gap)
+          {
+            break;
+          }
+          // Otherwise a timer is due on the next scan, no need to ask
+        }
+        scan_no++;
+        old_board->scan();
+        new_board->scan();
+        g++;
+      }
+      old_board->key(e->row, e->col, e->pressed);
+      new_board->key(e->row, e->col, e->pressed);
+      // keyboard_task takes one matrix change per scan; with a zero gap the
+      // next event queues behind this one, as a fast roll would
+      scan_no++;
+      old_board->scan();
+      new_board->scan();
+
+      if (!compare(&old_side, &new_side, &ea, &eb))
+      {
+        event_t ordered[HISTORY];
+        int nh = done + 1 < HISTORY ? done + 1 : HISTORY;
+        for (int k = 0; k < nh; k++)
+        {
+          ordered[k] = history[(done + 1 - nh + k) % HISTORY];
+        }
+        print_divergence(shard, seed, done, ordered, nh, ea, eb);
+        res.diverged = true;
+        done++;
+        goto out;
+      }
+    }
+  }
+out:
+  res.seconds = now() - t0;
+  res.events = done;
+  res.scans = scan_no;
+  res.reports = old_side.total;
+  res.digest = digest;
+  return res;
+}
+
+static void usage(void)
+{
+  fprintf(stderr, "usage: replay [-j shards] [-n events] [-s seed] [-g mean_gap] "
+                  "[-t tolerance] [-r events.txt] [-w events.txt] [-S] old.so new.so\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  int shards = sysconf(_SC_NPROCESSORS_ONLN);
+  uint64_t nevents = 1000000;
+  uint64_t seed = 1;
+  double mean_gap = 8;
+  const char *record_in = NULL, *record_out = NULL;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "j:n:s:g:t:r:w:S")) != -1)
+  {
+    switch (opt)
+    {
+    case 'j':
+      shards = atoi(optarg);
+      break;
+    case 'n':
+      nevents = strtoull(optarg, NULL, 0);
+      break;
+    case 's':
+      seed = strtoull(optarg, NULL, 0);
+      break;
+    case 'g':
+      mean_gap = atof(optarg);
+      break;
+    case 't':
+      tolerance = atoi(optarg);
+      break;
+    case 'r':
+      record_in = optarg;
+      break;
+    case 'w':
+      record_out = optarg;
+      break;
+    case 'S':
+      skip_idle = false;
+      break;
+    default:
+      usage();
+    }
+  }
+  if (argc - optind != 2 || shards < 1)
+  {
+    usage();
+  }
+  old_board = sim_load(argv[optind]);
+  new_board = sim_load(argv[optind + 1]);
+  if (old_board->rows != new_board->rows || old_board->cols != new_board->cols)
+  {
+    fprintf(stderr, "builds are for different matrices\n");
+    return 2;
+  }
+  if (record_in || record_out)
+  {
+    shards = 1;
+  }
+
+  FILE *in = NULL, *out = NULL;
+  if (record_in && !(in = fopen(record_in, "r")))
+  {
+    perror(record_in);
+    return 2;
+  }
+  if (record_out && !(out = fopen(record_out, "w")))
+  {
+    perror(record_out);
+    return 2;
+  }
+
+  int fds[shards];
+  pid_t pids[shards];
+  double t0 = now();
+  for (int i = 0; i < shards; i++)
+  {
+    int p[2];
+    if (pipe(p) < 0)
+    {
+      perror("pipe");
+      return 2;
+    }
+    fflush(stdout);
+    pids[i] = fork();
+    if (pids[i] == 0)
+    {
+      close(p[0]);
+      result_t r = run_shard(i, seed + i, record_in ? UINT64_MAX : nevents, mean_gap, in, out);
+      if (out)
+      {
+        fclose(out);
+      }
+      fflush(stdout);
+      if (write(p[1], &r, sizeof(r)) != sizeof(r))
+      {
+        _exit(2);
+      }
+      _exit(0);
+    }
+    close(p[1]);
+    fds[i] = p[0];
+  }
+
+  result_t total = {0};
+  for (int i = 0; i < shards; i++)
+  {
+    result_t r = {0};
+    if (read(fds[i], &r, sizeof(r)) != sizeof(r))
+    {
+      fprintf(stderr, "shard %d died\n", i);
+      total.diverged = true;
+    }
+    waitpid(pids[i], NULL, 0);
+    total.events += r.events;
+    total.scans += r.scans;
+    total.reports += r.reports;
+    total.skipped += r.skipped;
+    total.digest = total.digest * 0x100000001B3ULL ^ r.digest;
+    total.diverged |= r.diverged;
+  }
+  double wall = now() - t0;
+
+  double rate = total.events / wall;
+  printf("%s: %llu events, %llu scans (%llu skipped idle), %llu reports over %d shard%s in "
+         "%.2f s\n",
+         total.diverged ? "DIVERGED" : "identical", (unsigned long long)total.events,
+         (unsigned long long)total.scans, (unsigned long long)total.skipped,
+         (unsigned long long)total.reports, shards, shards == 1 ? "" : "s", wall);
+  printf("%.1fM events/s, %.0f%% of the %.0fM target; %.1fM scans/s; digest %016llx\n",
+         rate / 1e6, 100 * rate / TARGET_EVENTS_PER_S, TARGET_EVENTS_PER_S / 1e6,
+         total.scans / wall / 1e6, (unsigned long long)total.digest);
+  return total.diverged ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+/* Per-scan cost of the ErgoDox keymap's timer wheel
+ *
+ *   sched_bench [-n scans] [-s seed] [timer counts ...]
+ *
+ * Keeps each number of timers (default 1 2 4 8 16 32) live through
+ * scheduler.c itself, every callback re-arming with a new random delay of
+ * 1-2000ms, and runs that against the same deadlines polled with
+ * timer_elapsed() every scan. Reports timer entries looked at per scan,
+ * host time per scan, and how late callbacks ran against the delay they
+ * asked for, which must stay under one tick.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "qmk_sim.h"
+
+/* scheduler.c on a clock the bench advances, with room for every count */
+
+#define SCHED_TIMERS 64
+#include "../ergodox_ez/heartrobotninja/scheduler.c"
+
+static uint32_t clock_ms;
+
+uint16_t timer_read(void)
+{
+  return clock_ms;
+}
+
+uint16_t timer_elapsed(uint16_t last)
+{
+  return (uint16_t)(clock_ms - last);
+}
+
+static uint64_t rng;
+
+static uint16_t next_delay(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return 1 + (rng >> 16) % 2000;
+}
+
+/* Timers */
+
+typedef struct
+{
+  uint32_t due;
+} bench_timer_t;
+
+static unsigned long fired, worst_late, late_total, early;
+
+static uint16_t bench_fire(void *data)
+{
+  bench_timer_t *t = data;
+  uint32_t late = clock_ms - t->due;
+  if ((int32_t)late < 0)
+  {
+    early++;
+  }
+  else
+  {
+    late_total += late;
+    if (late > worst_late)
+    {
+      worst_late = late;
+    }
+  }
+  fired++;
+  uint16_t delay = next_delay();
+  t->due = clock_ms + delay;
+  return delay;
+}
+
+// Timers in the slot the next tick will walk
+static unsigned slot_length(uint8_t slot)
+{
+  unsigned n = 0;
+  for (uint8_t i = wheel[slot]; i != SCHED_NONE; i = timers[i].next)
+  {
+    n++;
+  }
+  return n;
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// What the keymap did before: a start and a length per timer, every scan
+uint16_t polled_start[SCHED_TIMERS], polled_delay[SCHED_TIMERS];
+
+static bench_timer_t bench[SCHED_TIMERS];
+
+static bool start_wheel(int count)
+{
+  started = false;
+  cursor = 0;
+  live = 0;
+  clock_ms = 0;
+  for (int i = 0; i < count; i++)
+  {
+    uint16_t delay = next_delay();
+    bench[i].due = delay;
+    if (sched_defer(delay, bench_fire, &bench[i]) == SCHED_NONE)
+    {
+      fprintf(stderr, "sched_defer failed at %d timers\n", i);
+      return false;
+    }
+  }
+  return true;
+}
+
+static int run(int count, unsigned long scans)
+{
+  // Once to count and check, once to time
+  fired = worst_late = late_total = early = 0;
+  if (!start_wheel(count))
+  {
+    return 1;
+  }
+  unsigned long visited = 0;
+  for (unsigned long s = 0; s < scans; s++)
+  {
+    clock_ms++;
+    if (timer_elapsed(wheel_time) >= SCHED_TICK_MS)
+    {
+      visited += slot_length((cursor + 1) % SCHED_SLOTS);
+    }
+    sched_task();
+  }
+  unsigned long wheel_fired = fired, wheel_late = late_total, wheel_worst = worst_late;
+  bool wheel_bad = early || worst_late >= SCHED_TICK_MS;
+
+  start_wheel(count);
+  double t0 = now();
+  for (unsigned long s = 0; s < scans; s++)
+  {
+    clock_ms++;
+    sched_task();
+  }
+  double elapsed = now() - t0;
+
+  clock_ms = 0;
+  for (int i = 0; i < count; i++)
+  {
+    polled_start[i] = 0;
+    polled_delay[i] = next_delay();
+  }
+  t0 = now();
+  for (unsigned long s = 0; s < scans; s++)
+  {
+    clock_ms++;
+    for (int i = 0; i < count; i++)
+    {
+      if (timer_elapsed(polled_start[i]) >= polled_delay[i])
+      {
+        polled_start[i] = timer_read();
+        polled_delay[i] = next_delay();
+      }
+    }
+  }
+  double polled_elapsed = now() - t0;
+
+  printf("%6d %8.3f %8.1f %8d %8.1f %7lu %6.2f %5lu%s\n", count, 1 + (double)visited / scans,
+         elapsed / scans * 1e9, count, polled_elapsed / scans * 1e9, wheel_fired,
+         wheel_fired ? (double)wheel_late / wheel_fired : 0, wheel_worst,
+         wheel_bad ? "  OUT OF TICK" : "");
+  return wheel_bad;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned long scans = 1000000;
+  int opt;
+
+  rng = 0x9E3779B97F4A7C15ULL;
+  while ((opt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'n':
+      scans = strtoul(optarg, NULL, 0);
+      break;
+    case 's':
+      rng ^= strtoull(optarg, NULL, 0) * 0x2545F4914F6CDD1DULL;
+      break;
+    default:
+      fprintf(stderr, "usage: sched_bench [-n scans] [-s seed] [timer counts ...]\n");
+      return 2;
+    }
+  }
+
+  printf("#  checks: timer entries looked at per scan, the clock compare included;\n"
+         "#  late: ms after the asked-for time, tick %dms, wheel %d slots\n",
+         SCHED_TICK_MS, SCHED_SLOTS);
+  printf("%6s %8s %8s %8s %8s %7s %6s %5s\n", "timers", "checks", "ns/scan", "polled",
+         "ns/scan", "fired", "late", "worst");
+
+  static const int default_counts[] = {1, 2, 4, 8, 16, 32};
+  int ncounts = argc - optind;
+  int failures = 0;
+  for (int i = 0; i < (ncounts ? ncounts : 6); i++)
+  {
+    int n = ncounts ? atoi(argv[optind + i]) : default_counts[i];
+    if (n < 1 || n > SCHED_TIMERS)
+    {
+      fprintf(stderr, "timer counts go from 1 to %d\n", SCHED_TIMERS);
+      return 2;
+    }
+    failures += run(n, scans);
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+#ifndef SIM_H
+#define SIM_H
+
+/* Interface between a compiled keymap and the host tools
+ *
+ * The Makefile builds each board's keymap.c, its rules.mk SRC files and the
+ * QMK stand-in runtime into build/<board>.so. Everything in it is hidden
+ * except sim_board, so two builds of the same keymap can be loaded into one
+ * process without their globals colliding.
+ */
+
+#include "qmk_sim.h"
+
+typedef void (*sim_report_fn)(void *ctx, const report_keyboard_t *report);
+typedef void (*sim_mouse_fn)(void *ctx, const report_mouse_t *report);
+typedef void (*sim_serial_fn)(void *ctx, uint8_t byte);
+typedef void (*sim_event_fn)(void *ctx, keyevent_t event);
+
+/* One pass of keyboard_task. QMK's loop runs well above 1kHz on the 32U4;
+ * 1ms keeps sim time and scan counts easy to relate.
+ */
+#define SIM_SCAN_US 1000
+
+typedef struct
+{
+  const char *keyboard;
+  uint8_t rows;
+  uint8_t cols;
+  uint8_t layers;
+  uint8_t split_rows; // rows per half of a split board, 0 when it isn't
+  const uint16_t *keymaps; // [layers][rows][cols]
+  const uint8_t *fingers;  // [rows][cols], enum sim_finger
+  uint8_t tap_dance_count;
+  uint16_t tapping_term;
+  uint16_t oneshot_timeout;
+  uint16_t leader_timeout;
+
+  // Returns false unless tap dance n is an ACTION_TAP_DANCE_DOUBLE
+  bool (*tap_dance_pair)(uint8_t n, uint16_t *kc1, uint16_t *kc2);
+
+  // Running the keymap: init once, then set matrix bits with key() and
+  // advance one scan at a time. Every keyboard report goes to the hook, and
+  // the mouse reports and virtual serial bytes to theirs.
+  void (*init)(void);
+  void (*key)(uint8_t row, uint8_t col, bool pressed);
+  void (*scan)(void);
+  bool (*idle)(void); // no matrix change, tap key or keymap task pending
+  // Scans the board can skip now, which only moves its clock on: nothing
+  // waits on a scan and no timer, tap key or tap dance falls due before the
+  // scan after them. 0 when the next scan has work to do.
+  uint32_t (*idle_scans)(void);
+  void (*skip)(uint32_t scans);
+  void (*set_report_hook)(sim_report_fn fn, void *ctx);
+  void (*set_mouse_hook)(sim_mouse_fn fn, void *ctx);
+  void (*set_serial_hook)(sim_serial_fn fn, void *ctx);
+  void (*layer_on)(uint8_t layer); // for tools that exercise one layer
+  // Each matrix event as keyboard_task hands it on, in processing order
+  void (*set_event_hook)(sim_event_fn fn, void *ctx);
+  // Split boards: the slave half's rows reach the master delay scans late,
+  // and with merged both halves go through the keymap's split_link.c.
+  // False when merged is asked of a keymap without one.
+  bool (*set_link)(bool right_is_master, uint8_t delay, bool merged);
+  uint64_t (*now_us)(void);
+  void (*set_leds)(uint8_t leds); // lock LEDs the host sends back, USB_LED_* bits
+
+  // Entry points of optional keymap modules, NULL when not linked in
+  void (*unicode_send)(uint8_t method, uint32_t code_point);
+  void (*snippet_send)(uint8_t n);
+  bool (*mouse_keys)(uint16_t keycode, keyrecord_t *record);
+  bool (*steno_keys)(uint16_t keycode, keyrecord_t *record);
+} sim_board_t;
+
+#define SIM_KEYMAP_AT(b, layer, row, col) \
+  ((b)->keymaps[((size_t)(layer) * (b)->rows + (row)) * (b)->cols + (col)])
+
+/* loader.c, host tools only: dlopen a keymap build, exits on failure */
+const sim_board_t *sim_load(const char *path);
+
+/* keycodes.c, linked into the runtime and into every tool */
+const char *sim_keycode_name(uint16_t keycode, char *buf, size_t len);
+char sim_keycode_char(uint16_t keycode, bool shifted);
+uint16_t sim_char_keycode(char c);
+
+#endif
@@ -0,0 +1,165 @@
+/* Emission rate of the keymap's text snippets
+ *
+ *   snippet_cost [-p poll_ms] keymap.so snippets.txt
+ *
+ * Starts each snippet through the keymap's snippet_send() and scans until
+ * its reports stop. Reports how many reports and how long each one takes,
+ * the slower of one scan per report and one USB poll per report (-p, 1ms
+ * for the NKRO endpoint, 10ms for the boot keyboard one), and checks the
+ * text the host would see against snippets.txt.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim.h"
+#include "snippets_src.h"
+
+typedef struct
+{
+  report_keyboard_t prev;
+  unsigned reports;
+  char text[SNIPPET_TEXT_MAX * 2];
+  size_t len;
+} host_t;
+
+static void host_report(void *ctx, const report_keyboard_t *r)
+{
+  host_t *h = ctx;
+  bool shifted = r->mods & (MOD_BIT(KC_LSFT) | MOD_BIT(KC_RSFT));
+
+  h->reports++;
+  for (int code = 0; code < 256; code++)
+  {
+    uint8_t bit = 1 << (code & 7);
+    if ((r->bits[code >> 3] & bit) && !(h->prev.bits[code >> 3] & bit) &&
+        h->len < sizeof(h->text) - 1)
+    {
+      char c = sim_keycode_char(code, shifted);
+      h->text[h->len++] = c ? c : '?';
+    }
+  }
+  h->prev = *r;
+}
+
+// The text with placeholders as the sim build fills them in
+static size_t expand(const snippet_src_t *s, const sim_board_t *board, char *out, size_t size)
+{
+  size_t n = 0;
+  for (int i = 0; i < s->length; i++)
+  {
+    const char *part = s->text[i] == SNIPPET_PH_KEYBOARD ? board->keyboard
+                       : s->text[i] == SNIPPET_PH_KEYMAP ? "heartrobotninja"
+                       : s->text[i] == SNIPPET_PH_VERSION ? "sim"
+                                                          : NULL;
+    if (part)
+    {
+      n += snprintf(out + n, size - n, "%s", part);
+    }
+    else if (n < size - 1)
+    {
+      out[n++] = s->text[i];
+    }
+  }
+  out[n] = 0;
+  return n;
+}
+
+int main(int argc, char **argv)
+{
+  double poll_ms = 1;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'p':
+      poll_ms = atof(optarg);
+      break;
+    default:
+      fprintf(stderr, "usage: snippet_cost [-p poll_ms] keymap.so snippets.txt\n");
+      return 2;
+    }
+  }
+  if (optind + 2 != argc)
+  {
+    fprintf(stderr, "usage: snippet_cost [-p poll_ms] keymap.so snippets.txt\n");
+    return 2;
+  }
+
+  const sim_board_t *board = sim_load(argv[optind]);
+  if (!board->snippet_send)
+  {
+    fprintf(stderr, "%s: keymap has no snippets.c\n", argv[optind]);
+    return 2;
+  }
+  FILE *in = fopen(argv[optind + 1], "r");
+  if (!in)
+  {
+    perror(argv[optind + 1]);
+    return 2;
+  }
+  snippet_src_t *snippets;
+  int count = snippets_parse(in, argv[optind + 1], &snippets);
+  fclose(in);
+  if (count <= 0)
+  {
+    return 2;
+  }
+
+  static host_t host;
+  board->set_report_hook(host_report, &host);
+  board->init();
+
+  int failures = 0;
+  size_t total_chars = 0;
+  unsigned total_reports = 0;
+  double total_ms = 0;
+  printf("%-6s %6s %7s %8s %8s\n", "keys", "chars", "reports", "ms", "chars/s");
+  for (int i = 0; i < count; i++)
+  {
+    static char expected[SNIPPET_TEXT_MAX * 2];
+    size_t len = expand(&snippets[i], board, expected, sizeof(expected));
+
+    memset(&host, 0, sizeof(host));
+    board->snippet_send(i);
+    unsigned scans = 0, quiet = 0, last = 0;
+    while (quiet < 3)
+    {
+      unsigned before = host.reports;
+      board->scan();
+      scans++;
+      if (host.reports != before)
+      {
+        last = scans;
+        quiet = 0;
+      }
+      else
+      {
+        quiet++;
+      }
+    }
+
+    double ms = last * SIM_SCAN_US / 1000.0;
+    if (host.reports * poll_ms > ms)
+    {
+      ms = host.reports * poll_ms;
+    }
+    bool ok = host.len == len && !memcmp(host.text, expected, len);
+    printf("%-6s %6zu %7u %8.1f %8.0f%s\n", snippets[i].trigger, len, host.reports, ms,
+           len / ms * 1000, ok ? "" : "  TEXT DIFFERS");
+    if (!ok)
+    {
+      printf("  expected \"%s\"\n  host saw \"%.*s\"\n", expected, (int)host.len, host.text);
+    }
+    failures += !ok;
+    total_chars += len;
+    total_reports += host.reports;
+    total_ms += ms;
+  }
+  printf("%-6s %6zu %7u %8.1f %8.0f\n", "all", total_chars, total_reports, total_ms,
+         total_chars / total_ms * 1000);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,232 @@
+/* Compresses a keymap's snippets.txt into its snippets_data.h
+ *
+ *   snippets_gen snippets.txt snippets_data.h
+ *
+ * Byte pair encoding: the most frequent pair of adjacent symbols becomes a
+ * new symbol 0x80 + n, again and again until no pair is used three times
+ * (below that, the two byte table entry costs what it saves) or all 128
+ * symbols are taken. Pairs never span two snippets, so each snippet starts
+ * at an index of its own and ends at a 0.
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snippets_src.h"
+
+#define MAX_PAIRS 128
+
+static uint8_t pairs[MAX_PAIRS][2];
+static uint8_t pair_depth[MAX_PAIRS];
+static int npairs;
+
+static int symbol_depth(uint8_t sym)
+{
+  return sym & 0x80 ? pair_depth[sym & 0x7F] : 0;
+}
+
+static void compress(snippet_src_t *s, int count, uint8_t **seqs, int *lens)
+{
+  static unsigned counts[256][256];
+
+  for (int i = 0; i < count; i++)
+  {
+    seqs[i] = malloc(s[i].length);
+    memcpy(seqs[i], s[i].text, s[i].length);
+    lens[i] = s[i].length;
+  }
+
+  while (npairs < MAX_PAIRS)
+  {
+    memset(counts, 0, sizeof(counts));
+    for (int i = 0; i < count; i++)
+    {
+      for (int j = 0; j + 1 < lens[i]; j++)
+      {
+        counts[seqs[i][j]][seqs[i][j + 1]]++;
+        // "aaa" holds one "aa" that can be replaced, not two
+        if (j + 2 < lens[i] && seqs[i][j] == seqs[i][j + 1] && seqs[i][j] == seqs[i][j + 2])
+        {
+          j++;
+        }
+      }
+    }
+
+    unsigned best = 0;
+    int a = 0, b = 0;
+    for (int x = 0; x < 256; x++)
+    {
+      for (int y = 0; y < 256; y++)
+      {
+        if (counts[x][y] > best)
+        {
+          best = counts[x][y];
+          a = x;
+          b = y;
+        }
+      }
+    }
+    if (best < 3)
+    {
+      break;
+    }
+
+    uint8_t sym = 0x80 | npairs;
+    pairs[npairs][0] = a;
+    pairs[npairs][1] = b;
+    pair_depth[npairs] = 1 + (symbol_depth(a) > symbol_depth(b) ? symbol_depth(a) : symbol_depth(b));
+    npairs++;
+    for (int i = 0; i < count; i++)
+    {
+      int out = 0;
+      for (int j = 0; j < lens[i]; j++)
+      {
+        if (j + 1 < lens[i] && seqs[i][j] == a && seqs[i][j + 1] == b)
+        {
+          seqs[i][out++] = sym;
+          j++;
+        }
+        else
+        {
+          seqs[i][out++] = seqs[i][j];
+        }
+      }
+      lens[i] = out;
+    }
+  }
+}
+
+static uint8_t trigger_key(char c)
+{
+  // KC_A is 4, KC_1 is 30 and KC_0 39
+  if (c >= 'a' && c <= 'z')
+  {
+    return 4 + c - 'a';
+  }
+  return c == '0' ? 39 : 30 + c - '1';
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 3)
+  {
+    fprintf(stderr, "usage: snippets_gen snippets.txt out.h\n");
+    return 2;
+  }
+
+  FILE *in = fopen(argv[1], "r");
+  if (!in)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  snippet_src_t *snippets;
+  int count = snippets_parse(in, argv[1], &snippets);
+  fclose(in);
+  if (count <= 0)
+  {
+    if (count == 0)
+    {
+      fprintf(stderr, "%s: no snippets\n", argv[1]);
+    }
+    return 1;
+  }
+  for (int i = 0; i < count; i++)
+  {
+    if (!strcmp(snippets[i].trigger, "count") || !strcmp(snippets[i].trigger, "depth"))
+    {
+      fprintf(stderr, "%s: \"%s\" is taken by the generated header\n", argv[1],
+              snippets[i].trigger);
+      return 1;
+    }
+  }
+
+  uint8_t **seqs = malloc(count * sizeof(uint8_t *));
+  int *lens = malloc(count * sizeof(int));
+  compress(snippets, count, seqs, lens);
+
+  size_t raw = 0, text = 0;
+  int depth = 0;
+  for (int i = 0; i < count; i++)
+  {
+    raw += snippets[i].length + 1;
+    text += lens[i] + 1;
+    for (int j = 0; j < lens[i]; j++)
+    {
+      if (symbol_depth(seqs[i][j]) > depth)
+      {
+        depth = symbol_depth(seqs[i][j]);
+      }
+    }
+  }
+  size_t total = text + 2 * npairs + 2 * count;
+
+  FILE *out = fopen(argv[2], "w");
+  if (!out)
+  {
+    perror(argv[2]);
+    return 1;
+  }
+  fprintf(out, "// Generated by sim/build/snippets_gen from snippets.txt, do not edit\n"
+               "// %d snippets, %zu bytes of text in %zu bytes with %d pairs and the index\n\n"
+               "#ifndef SNIPPETS_DATA_H\n"
+               "#define SNIPPETS_DATA_H\n\n"
+               "enum\n{\n",
+          count, raw, total, npairs);
+  for (int i = 0; i < count; i++)
+  {
+    fprintf(out, "  SNIPPET_");
+    for (const char *c = snippets[i].trigger; *c; c++)
+    {
+      fputc(toupper((unsigned char)*c), out);
+    }
+    fprintf(out, ",\n");
+  }
+  fprintf(out, "  SNIPPET_COUNT,\n};\n\n"
+               "#ifdef SNIPPET_TABLES\n\n"
+               "// Placeholders for the build strings\n"
+               "#define SNIPPET_KEYBOARD %d\n"
+               "#define SNIPPET_KEYMAP %d\n"
+               "#define SNIPPET_VERSION %d\n\n"
+               "#define SNIPPET_DEPTH %d\n\n"
+               "static const uint8_t PROGMEM snippet_triggers[SNIPPET_COUNT][5] = {\n",
+          SNIPPET_PH_KEYBOARD, SNIPPET_PH_KEYMAP, SNIPPET_PH_VERSION, depth ? depth : 1);
+  for (int i = 0; i < count; i++)
+  {
+    fprintf(out, "        {");
+    for (int k = 0; k < SNIPPET_TRIGGER_MAX; k++)
+    {
+      char c = snippets[i].trigger[k];
+      fprintf(out, "%s%d", k ? ", " : "", c ? trigger_key(c) : 0);
+    }
+    fprintf(out, "}, // %s\n", snippets[i].trigger);
+  }
+  fprintf(out, "};\n\nstatic const uint16_t PROGMEM snippet_index[SNIPPET_COUNT] = {");
+  size_t pos = 0;
+  for (int i = 0; i < count; i++)
+  {
+    fprintf(out, "%s%zu,", i % 12 ? " " : "\n        ", pos);
+    pos += lens[i] + 1;
+  }
+  fprintf(out, "\n};\n\nstatic const uint8_t PROGMEM snippet_pairs[%d][2] = {", npairs ? npairs : 1);
+  for (int i = 0; i < npairs; i++)
+  {
+    fprintf(out, "%s{0x%02X, 0x%02X},", i % 6 ? " " : "\n        ", pairs[i][0], pairs[i][1]);
+  }
+  fprintf(out, "\n};\n\nstatic const uint8_t PROGMEM snippet_text[%zu] = {", text);
+  pos = 0;
+  for (int i = 0; i < count; i++)
+  {
+    for (int j = 0; j <= lens[i]; j++, pos++)
+    {
+      fprintf(out, "%s0x%02X,", pos % 12 ? " " : "\n        ", j < lens[i] ? seqs[i][j] : 0);
+    }
+  }
+  fprintf(out, "\n};\n\n#endif\n\n#endif\n");
+  fclose(out);
+
+  printf("%s: %d snippets, %zu bytes as strings, %zu compressed (text %zu, pairs %d, index %d), "
+         "ratio %.2f, stack %d\n",
+         argv[2], count, raw, total, text, 2 * npairs, 2 * count, (double)raw / total, depth);
+  return 0;
+}
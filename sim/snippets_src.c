@@ -0,0 +1,107 @@
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snippets_src.h"
+
+static const char *const placeholders[] = {"{keyboard}", "{keymap}", "{version}"};
+
+static int parse_text(const char *s, uint8_t *out)
+{
+  int n = 0;
+
+  while (*s && *s != '\n' && n < SNIPPET_TEXT_MAX - 1)
+  {
+    if (*s == '\\')
+    {
+      char c = s[1];
+      if (c != 'n' && c != 't' && c != '\\')
+      {
+        return -1;
+      }
+      out[n++] = c == 'n' ? '\n' : c == 't' ? '\t' : '\\';
+      s += 2;
+      continue;
+    }
+    if (*s == '{')
+    {
+      int ph;
+      for (ph = 0; ph < 3; ph++)
+      {
+        size_t len = strlen(placeholders[ph]);
+        if (!strncmp(s, placeholders[ph], len))
+        {
+          out[n++] = SNIPPET_PH_KEYBOARD + ph;
+          s += len;
+          break;
+        }
+      }
+      if (ph < 3)
+      {
+        continue;
+      }
+    }
+    if (*s < ' ' || *s > '~')
+    {
+      return -1;
+    }
+    out[n++] = *s++;
+  }
+  out[n] = 0;
+  return n;
+}
+
+int snippets_parse(FILE *in, const char *name, snippet_src_t **snippets)
+{
+  char line[SNIPPET_TEXT_MAX * 2];
+  int count = 0, cap = 0, lineno = 0;
+
+  *snippets = NULL;
+  while (fgets(line, sizeof(line), in))
+  {
+    lineno++;
+    if (line[0] == '#' || line[0] == '\n')
+    {
+      continue;
+    }
+
+    char *p = line;
+    char trigger[SNIPPET_TRIGGER_MAX + 1];
+    int t = 0;
+    while (isalnum((unsigned char)*p) && t <= SNIPPET_TRIGGER_MAX)
+    {
+      trigger[t++] = tolower((unsigned char)*p++);
+    }
+    if (t == 0 || t > SNIPPET_TRIGGER_MAX || *p != ' ')
+    {
+      fprintf(stderr, "%s:%d: expected up to %d letters or digits, a space, then the text\n", name,
+              lineno, SNIPPET_TRIGGER_MAX);
+      return -1;
+    }
+    trigger[t] = 0;
+
+    if (count == cap)
+    {
+      cap = cap ? cap * 2 : 32;
+      *snippets = realloc(*snippets, cap * sizeof(snippet_src_t));
+    }
+    snippet_src_t *s = &(*snippets)[count];
+    strcpy(s->trigger, trigger);
+    s->length = parse_text(p + 1, s->text);
+    if (s->length <= 0)
+    {
+      fprintf(stderr, "%s:%d: text must be printable ASCII and \\n \\t \\\\ escapes\n", name,
+              lineno);
+      return -1;
+    }
+    for (int i = 0; i < count; i++)
+    {
+      if (!strcmp((*snippets)[i].trigger, trigger))
+      {
+        fprintf(stderr, "%s:%d: \"%s\" is already used\n", name, lineno, trigger);
+        return -1;
+      }
+    }
+    count++;
+  }
+  return count;
+}
@@ -0,0 +1,36 @@
+#ifndef SNIPPETS_SRC_H
+#define SNIPPETS_SRC_H
+
+/* Reads a keymap's snippets.txt, shared by snippets_gen and snippet_cost.
+ *
+ * One snippet per line: "<leader keys> <text>". The text runs to the end
+ * of the line with \n, \t and \\ escapes, and {keyboard}, {keymap} and
+ * {version} expand on the keyboard to the firmware's build strings. '#'
+ * starts a comment line.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define SNIPPET_TRIGGER_MAX 5
+#define SNIPPET_TEXT_MAX 1024
+
+// Placeholder bytes in decoded text
+enum
+{
+  SNIPPET_PH_KEYBOARD = 1,
+  SNIPPET_PH_KEYMAP,
+  SNIPPET_PH_VERSION,
+};
+
+typedef struct
+{
+  char trigger[SNIPPET_TRIGGER_MAX + 1];
+  uint8_t text[SNIPPET_TEXT_MAX]; // 0 terminated, placeholders as above
+  int length;
+} snippet_src_t;
+
+// Returns the number of snippets read, -1 after printing a parse error
+int snippets_parse(FILE *in, const char *name, snippet_src_t **snippets);
+
+#endif
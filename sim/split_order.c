@@ -0,0 +1,285 @@
+/* Cross-half rolls over a split keymap's serial link
+ *
+ *   split_order [-n rolls] [-s seed] [-d max_delay] [-r] keymap.so
+ *
+ * Types -n fast rolls (default 2000) of 2-6 keys that alternate between the
+ * halves, 1-40ms between presses and each held 30-150ms, with the board
+ * idle in between. Every roll goes through one copy of the keymap per link
+ * setting: the slave's rows 0 to -d scans late (default 4), read as the
+ * stock matrix.c has them, or merged by the keymap's own split_link.c told
+ * that latency. The left half is the master unless -r.
+ *
+ * Counts the rolls whose key events reach the keymap in a different order
+ * than the fingers made them, those whose keyboard reports differ from an
+ * instant link's, and how much later than the key change each event is
+ * processed on average.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "sim.h"
+
+#define MAX_DELAY 15
+#define MAX_ROLL 6
+#define MAX_EVENTS (2 * MAX_ROLL)
+#define MAX_POS 256
+#define IDLE_SCANS 200
+
+typedef struct
+{
+  uint32_t at; // scan of the roll it happens in
+  uint8_t row;
+  uint8_t col;
+  bool pressed;
+} event_t;
+
+typedef struct
+{
+  const sim_board_t *board;
+  uint8_t delay;
+  bool merged;
+  uint32_t scan;
+
+  // This roll, as the keymap saw it
+  event_t events[MAX_EVENTS];
+  unsigned nevents;
+  uint64_t reports; // FNV-1a of every report's contents, in order
+
+  unsigned reordered;
+  unsigned diverged;
+  uint64_t lag;
+  unsigned lagged;
+} link_t;
+
+typedef struct
+{
+  uint8_t row, col;
+} pos_t;
+
+static pos_t left[MAX_POS], right[MAX_POS];
+static int nleft, nright;
+
+static uint64_t rng = 0x5DEECE66D;
+
+static uint32_t next_rand(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng >> 16;
+}
+
+static void link_event(void *ctx, keyevent_t event)
+{
+  link_t *link = ctx;
+  if (link->nevents < MAX_EVENTS)
+  {
+    link->events[link->nevents++] = (event_t){link->scan, event.key.row, event.key.col, event.pressed};
+  }
+}
+
+static void link_report(void *ctx, const report_keyboard_t *report)
+{
+  link_t *link = ctx;
+  const uint8_t *p = (const uint8_t *)report;
+  for (size_t i = 0; i < sizeof(*report); i++)
+  {
+    link->reports = (link->reports ^ p[i]) * 0x100000001B3ULL;
+  }
+}
+
+/* Keys only a basic keycode sits on with the base layer up, so no roll
+ * changes layers, locks anything or resets the board.
+ */
+static bool harmless(const sim_board_t *board, uint8_t r, uint8_t c)
+{
+  uint16_t kc = SIM_KEYMAP_AT(board, 0, r, c);
+  return kc >= KC_A && kc <= KC_SLASH;
+}
+
+static int roll(event_t *events)
+{
+  int n = 2 + next_rand() % (MAX_ROLL - 1);
+  bool used[MAX_POS * 2] = {false};
+  bool on_left = next_rand() % 2;
+  uint32_t t = 0;
+  bool taken[MAX_EVENTS * 200] = {false};
+  int nevents = 0;
+
+  for (int i = 0; i < n; i++, on_left = !on_left)
+  {
+    int k;
+    do
+    {
+      k = on_left ? (int)(next_rand() % nleft) : nleft + (int)(next_rand() % nright);
+    } while (used[k]);
+    used[k] = true;
+    pos_t p = k < nleft ? left[k] : right[k - nleft];
+
+    // Each change on a scan of its own, so the order the fingers made is clear
+    t += 1 + next_rand() % 40;
+    while (taken[t])
+    {
+      t++;
+    }
+    taken[t] = true;
+    uint32_t up = t + 30 + next_rand() % 121;
+    while (taken[up])
+    {
+      up++;
+    }
+    taken[up] = true;
+    events[nevents++] = (event_t){t, p.row, p.col, true};
+    events[nevents++] = (event_t){up, p.row, p.col, false};
+  }
+  // By time
+  for (int i = 1; i < nevents; i++)
+  {
+    for (int j = i; j > 0 && events[j].at < events[j - 1].at; j--)
+    {
+      event_t e = events[j];
+      events[j] = events[j - 1];
+      events[j - 1] = e;
+    }
+  }
+  return nevents;
+}
+
+static void run(link_t *link, const event_t *events, int nevents)
+{
+  link->scan = 0;
+  link->nevents = 0;
+  link->reports = 0xCBF29CE484222325ULL;
+
+  for (int i = 0; i < nevents || !link->board->idle(); link->scan++)
+  {
+    for (; i < nevents && events[i].at == link->scan; i++)
+    {
+      link->board->key(events[i].row, events[i].col, events[i].pressed);
+    }
+    link->board->scan();
+  }
+  for (int i = 0; i < IDLE_SCANS; i++)
+  {
+    link->board->scan();
+  }
+
+  bool same = link->nevents == (unsigned)nevents;
+  for (unsigned i = 0; i < link->nevents && i < (unsigned)nevents; i++)
+  {
+    const event_t *a = &link->events[i], *b = &events[i];
+    same &= a->row == b->row && a->col == b->col && a->pressed == b->pressed;
+    link->lag += a->at - b->at;
+    link->lagged++;
+  }
+  link->reordered += !same;
+}
+
+int main(int argc, char **argv)
+{
+  int rolls = 2000;
+  int max_delay = 4;
+  bool right_is_master = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:s:d:r")) != -1)
+  {
+    switch (opt)
+    {
+    case 'n':
+      rolls = atoi(optarg);
+      break;
+    case 's':
+      rng = strtoull(optarg, NULL, 0) | 1;
+      break;
+    case 'd':
+      max_delay = atoi(optarg);
+      break;
+    case 'r':
+      right_is_master = true;
+      break;
+    default:
+      optind = argc;
+    }
+  }
+  if (optind != argc - 1 || max_delay < 0 || max_delay > MAX_DELAY)
+  {
+    fprintf(stderr, "usage: split_order [-n rolls] [-s seed] [-d max_delay 0-%d] [-r] keymap.so\n",
+            MAX_DELAY);
+    return 2;
+  }
+
+  // One copy of the keymap per link setting, instant link first
+  int nlinks = 2 * (max_delay + 1);
+  link_t links[2 * (MAX_DELAY + 1)];
+  for (int i = 0; i < nlinks; i++)
+  {
+    link_t *link = &links[i];
+    *link = (link_t){.board = sim_load(argv[optind]), .delay = i / 2, .merged = i % 2};
+    if (!link->board->split_rows)
+    {
+      fprintf(stderr, "%s: not a split keyboard\n", argv[optind]);
+      return 2;
+    }
+    link->board->set_event_hook(link_event, link);
+    link->board->set_report_hook(link_report, link);
+    link->board->init();
+    if (!link->board->set_link(right_is_master, link->delay, link->merged))
+    {
+      fprintf(stderr, "%s: no split_link.c in this keymap\n", argv[optind]);
+      return 2;
+    }
+  }
+
+  const sim_board_t *board = links[0].board;
+  for (int r = 0; r < board->rows; r++)
+  {
+    for (int c = 0; c < board->cols && nleft < MAX_POS && nright < MAX_POS; c++)
+    {
+      if (harmless(board, r, c))
+      {
+        if (r < board->split_rows)
+        {
+          left[nleft++] = (pos_t){r, c};
+        }
+        else
+        {
+          right[nright++] = (pos_t){r, c};
+        }
+      }
+    }
+  }
+  if (nleft < MAX_ROLL || nright < MAX_ROLL)
+  {
+    fprintf(stderr, "%s: too few plain keys on the base layer of each half\n", argv[optind]);
+    return 2;
+  }
+
+  for (int n = 0; n < rolls; n++)
+  {
+    event_t events[MAX_EVENTS];
+    int nevents = roll(events);
+    for (int i = 0; i < nlinks; i++)
+    {
+      run(&links[i], events, nevents);
+      links[i].diverged += links[i].reports != links[0].reports;
+    }
+  }
+
+  printf("# %d rolls, %s half master, %d + %d plain keys\n", rolls,
+         right_is_master ? "right" : "left", nleft, nright);
+  printf("%-5s %-8s %10s %10s %10s\n", "delay", "link", "reordered", "diverged", "lag ms");
+  int failures = 0;
+  for (int i = 0; i < nlinks; i++)
+  {
+    link_t *link = &links[i];
+    printf("%-5u %-8s %10u %10u %10.2f\n", link->delay, link->merged ? "merged" : "plain",
+           link->reordered, link->diverged, link->lagged ? (double)link->lag / link->lagged : 0.0);
+    if (link->merged)
+    {
+      failures += link->reordered;
+    }
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,302 @@
+/* Chords through a keymap's STENO layer, decoded off its serial port
+ *
+ *   steno_check [-n strokes] [-s seed] keymap.so
+ *
+ * Switches the layer holding the STN_* keys on and, for GeminiPR and then
+ * TX Bolt, strokes every key alone, all of them at once, then -n random
+ * chords (default 1000). A chord's keys go down in random order with 0-3
+ * scans between events, some coming back up while others go down, the way
+ * fingers roll onto a stroke. Checks that each stroke decodes to exactly
+ * the keys pressed, as the protocol merges them, that the serial port gets
+ * at most one byte per scan, and that no keyboard report is sent.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "sim.h"
+#include "steno_proto.h"
+#include "../lets_split/heartrobotninja/steno.h"
+
+#define NKEYS (STN__MAX - STN__MIN + 1)
+#define DRAIN_SCANS 32
+
+typedef struct
+{
+  const sim_board_t *board;
+  uint64_t scan;
+  uint64_t last_byte_scan;
+  unsigned bytes;
+  unsigned bursts; // bytes sent in the same scan as the one before
+  unsigned reports;
+  steno_decoder_t decoder;
+  steno_stroke_t strokes[4];
+  unsigned nstrokes;
+} host_t;
+
+typedef struct
+{
+  bool present;
+  uint8_t row, col;
+} pos_t;
+
+static pos_t keys[NKEYS];
+static pos_t mode_keys[2]; // STN_GEMINI, STN_BOLT
+
+static uint64_t rng = 0x5DEECE66D;
+
+static uint32_t next_rand(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng >> 16;
+}
+
+static void host_serial(void *ctx, uint8_t byte)
+{
+  host_t *host = ctx;
+  if (host->bytes && host->last_byte_scan == host->scan)
+  {
+    host->bursts++;
+  }
+  host->bytes++;
+  host->last_byte_scan = host->scan;
+
+  steno_stroke_t stroke;
+  if (steno_decode(&host->decoder, byte, &stroke) && host->nstrokes < 4)
+  {
+    host->strokes[host->nstrokes++] = stroke;
+  }
+}
+
+static void host_report(void *ctx, const report_keyboard_t *report)
+{
+  ((host_t *)ctx)->reports++;
+}
+
+static void scan(host_t *host, int n)
+{
+  while (n--)
+  {
+    host->scan++;
+    host->board->scan();
+  }
+}
+
+static void event(host_t *host, pos_t p, bool pressed)
+{
+  host->board->key(p.row, p.col, pressed);
+  scan(host, 1 + next_rand() % 4);
+}
+
+// Key bit of each STN_* keycode in a decoded stroke
+static int stroke_bit(int key)
+{
+  return key / 8 * 7 + key % 8;
+}
+
+typedef struct
+{
+  unsigned strokes, failures;
+  uint64_t bytes, latency, max_latency;
+} stats_t;
+
+static void stroke(host_t *host, const int *chord, int n, stats_t *stats)
+{
+  int order[NKEYS] = {0};
+  bool down[NKEYS] = {false};
+  steno_stroke_t expect = 0;
+
+  for (int i = 0; i < n; i++)
+  {
+    order[i] = chord[i];
+    expect |= (steno_stroke_t)1 << stroke_bit(chord[i]);
+  }
+  for (int i = n - 1; i > 0; i--)
+  {
+    int j = next_rand() % (i + 1), t = order[i];
+    order[i] = order[j];
+    order[j] = t;
+  }
+
+  /* The first key down is the last up, so it stays one stroke; the others
+   * may come up as soon as they're down.
+   */
+  unsigned bytes = host->bytes;
+  event(host, keys[order[0]], true);
+  int next = 1, held = 0;
+  while (next < n || held)
+  {
+    if (next < n && (!held || next_rand() % 2))
+    {
+      down[next] = true;
+      held++;
+      event(host, keys[order[next++]], true);
+    }
+    else
+    {
+      int k = 1 + next_rand() % (next - 1);
+      while (!down[k])
+      {
+        k = k % (next - 1) + 1;
+      }
+      down[k] = false;
+      held--;
+      event(host, keys[order[k]], false);
+    }
+  }
+  host->board->key(keys[order[0]].row, keys[order[0]].col, false);
+  uint64_t released = host->scan;
+  host->nstrokes = 0;
+  scan(host, DRAIN_SCANS);
+
+  if (host->decoder.protocol == STENO_BOLT)
+  {
+    expect = steno_bolt_keys(expect);
+  }
+  stats->strokes++;
+  stats->bytes += host->bytes - bytes;
+  uint64_t latency = host->last_byte_scan - released;
+  stats->latency += latency;
+  if (latency > stats->max_latency)
+  {
+    stats->max_latency = latency;
+  }
+  // A chord of keys TX Bolt lacks sends nothing a stroke can be made of
+  unsigned want_strokes = expect ? 1 : 0;
+  if (host->nstrokes != want_strokes || (want_strokes && host->strokes[0] != expect))
+  {
+    char want[64], got[64];
+    printf("  pressed %s, got %u strokes%s%s\n", steno_stroke_str(expect, want, sizeof(want)),
+           host->nstrokes, host->nstrokes ? ", first " : "",
+           host->nstrokes ? steno_stroke_str(host->strokes[0], got, sizeof(got)) : "");
+    stats->failures++;
+  }
+}
+
+static void tap(host_t *host, pos_t p)
+{
+  host->board->key(p.row, p.col, true);
+  scan(host, 5);
+  host->board->key(p.row, p.col, false);
+  scan(host, 5);
+}
+
+int main(int argc, char **argv)
+{
+  int random_strokes = 1000;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'n':
+      random_strokes = atoi(optarg);
+      break;
+    case 's':
+      rng = strtoull(optarg, NULL, 0) | 1;
+      break;
+    default:
+      optind = argc;
+    }
+  }
+  if (optind != argc - 1)
+  {
+    fprintf(stderr, "usage: steno_check [-n strokes] [-s seed] keymap.so\n");
+    return 2;
+  }
+  const sim_board_t *board = sim_load(argv[optind]);
+  if (!board->steno_keys)
+  {
+    fprintf(stderr, "%s: keymap has no steno.c\n", argv[optind]);
+    return 2;
+  }
+
+  int layer = -1;
+  for (int l = 0; l < board->layers && layer < 0; l++)
+  {
+    for (int r = 0; r < board->rows; r++)
+    {
+      for (int c = 0; c < board->cols; c++)
+      {
+        uint16_t kc = SIM_KEYMAP_AT(board, l, r, c);
+        pos_t p = {true, r, c};
+        if (kc >= STN__MIN && kc <= STN__MAX && !keys[kc - STN__MIN].present)
+        {
+          keys[kc - STN__MIN] = p;
+          layer = l;
+        }
+        else if (kc == STN_GEMINI || kc == STN_BOLT)
+        {
+          mode_keys[kc - STN_GEMINI] = p;
+        }
+      }
+    }
+  }
+  if (layer < 0 || !mode_keys[0].present || !mode_keys[1].present)
+  {
+    fprintf(stderr, "%s: no layer with steno keys and STN_GEMINI/STN_BOLT\n", argv[optind]);
+    return 2;
+  }
+  int all[NKEYS], nall = 0;
+  for (int k = 0; k < NKEYS; k++)
+  {
+    if (keys[k].present)
+    {
+      all[nall++] = k;
+    }
+  }
+
+  host_t host = {.board = board};
+  board->set_serial_hook(host_serial, &host);
+  board->set_report_hook(host_report, &host);
+  board->init();
+  board->layer_on(layer);
+  printf("# layer %d, %d of %d steno keys\n", layer, nall, STENO_KEYS);
+  printf("%-8s %8s %8s %11s %12s %9s\n", "protocol", "strokes", "failed", "bytes/stroke",
+         "latency ms", "max ms");
+
+  int failures = 0;
+  unsigned errors = 0;
+  for (int protocol = STENO_GEMINI; protocol <= STENO_BOLT; protocol++)
+  {
+    stats_t stats = {0};
+    steno_decoder_init(&host.decoder, protocol);
+    tap(&host, mode_keys[protocol]);
+
+    for (int i = 0; i < nall; i++)
+    {
+      stroke(&host, &all[i], 1, &stats);
+    }
+    stroke(&host, all, nall, &stats);
+    for (int s = 0; s < random_strokes; s++)
+    {
+      int chord[NKEYS], n = 0;
+      unsigned density = 1 + next_rand() % 4;
+      for (int i = 0; i < nall; i++)
+      {
+        if (next_rand() % 8 < density)
+        {
+          chord[n++] = all[i];
+        }
+      }
+      if (n)
+      {
+        stroke(&host, chord, n, &stats);
+      }
+    }
+
+    printf("%-8s %8u %8u %11.2f %12.2f %9llu\n", protocol == STENO_BOLT ? "TX Bolt" : "GeminiPR",
+           stats.strokes, stats.failures, (double)stats.bytes / stats.strokes,
+           (double)stats.latency / stats.strokes, (unsigned long long)stats.max_latency);
+    failures += stats.failures;
+    errors += host.decoder.errors;
+  }
+
+  printf("serial bytes %u, sent in the same scan as the last: %u; keyboard reports: %u; "
+         "decode errors: %u\n",
+         host.bytes, host.bursts, host.reports, errors);
+  return failures || host.bursts || host.reports || errors ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+/* Prints the strokes in a steno serial stream
+ *
+ *   steno_decode [-b] [file]
+ *
+ * Reads GeminiPR, or TX Bolt with -b, from file or stdin and prints a
+ * stroke per line in steno order. Works on a capture or straight off the
+ * board's serial port, once stty has it in raw mode. Bytes that don't fit
+ * the protocol are counted and reported at the end.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "steno_proto.h"
+
+int main(int argc, char **argv)
+{
+  steno_protocol_t protocol = STENO_GEMINI;
+  int arg = 1;
+
+  if (arg < argc && !strcmp(argv[arg], "-b"))
+  {
+    protocol = STENO_BOLT;
+    arg++;
+  }
+  if (argc - arg > 1)
+  {
+    fprintf(stderr, "usage: steno_decode [-b] [file]\n");
+    return 2;
+  }
+  FILE *in = stdin;
+  if (arg < argc && !(in = fopen(argv[arg], "rb")))
+  {
+    perror(argv[arg]);
+    return 2;
+  }
+
+  steno_decoder_t decoder;
+  steno_decoder_init(&decoder, protocol);
+  steno_stroke_t stroke;
+  char buf[64];
+  unsigned strokes = 0;
+  int c;
+  while ((c = getc(in)) != EOF)
+  {
+    if (steno_decode(&decoder, c, &stroke))
+    {
+      puts(steno_stroke_str(stroke, buf, sizeof(buf)));
+      fflush(stdout);
+      strokes++;
+    }
+  }
+  if (decoder.errors)
+  {
+    fprintf(stderr, "%u strokes, %u bytes out of protocol\n", strokes, decoder.errors);
+    return 1;
+  }
+  return 0;
+}
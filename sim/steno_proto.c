@@ -0,0 +1,166 @@
+#include <string.h>
+#include "steno_proto.h"
+
+#define BIT(n) ((steno_stroke_t)1 << (n))
+
+const char *const steno_key_names[STENO_KEYS] = {
+        "Fn", "#1", "#2", "#3", "#4", "#5", "#6",
+        "S1-", "S2-", "T-", "K-", "P-", "W-", "H-",
+        "R-", "A-", "O-", "*1", "*2", "res1", "res2",
+        "pwr", "*3", "*4", "-E", "-U", "-F", "-R",
+        "-P", "-B", "-L", "-G", "-T", "-S", "-D",
+        "#7", "#8", "#9", "#A", "#B", "#C", "-Z"};
+
+#define NUMBERS (0x7EULL | 0x3FULL << 35)
+#define STARS (BIT(17) | BIT(18) | BIT(22) | BIT(23))
+#define EXTRAS (BIT(0) | BIT(19) | BIT(20) | BIT(21))
+#define MIDDLE (BIT(15) | BIT(16) | STARS | BIT(24) | BIT(25))
+#define RIGHT ((BIT(35) - BIT(26)) | BIT(41))
+
+// TX Bolt's keys, 6 to a group, as stroke bits
+static const uint8_t bolt_chart[4][6] = {
+        {7, 9, 10, 11, 12, 13},   // S- T- K- P- W- H-
+        {14, 15, 16, 17, 24, 25}, // R- A- O- * -E -U
+        {26, 27, 28, 29, 30, 31}, // -F -R -P -B -L -G
+        {32, 33, 34, 41, 1, 0},   // -T -S -D -Z #
+};
+
+void steno_decoder_init(steno_decoder_t *d, steno_protocol_t protocol)
+{
+  memset(d, 0, sizeof(*d));
+  d->protocol = protocol;
+  d->group = -1;
+}
+
+static bool decode_gemini(steno_decoder_t *d, uint8_t byte, steno_stroke_t *stroke)
+{
+  // Only the first byte of a packet has the top bit set
+  if (!!(byte & 0x80) != !d->length)
+  {
+    d->errors++;
+    if (!(byte & 0x80))
+    {
+      return false;
+    }
+    d->length = 0;
+  }
+  d->packet[d->length++] = byte;
+  if (d->length < sizeof(d->packet))
+  {
+    return false;
+  }
+
+  d->length = 0;
+  *stroke = 0;
+  for (int i = 0; i < 6; i++)
+  {
+    for (int j = 0; j < 7; j++)
+    {
+      if (d->packet[i] & (0x40 >> j))
+      {
+        *stroke |= BIT(i * 7 + j);
+      }
+    }
+  }
+  return *stroke != 0;
+}
+
+static bool decode_bolt(steno_decoder_t *d, uint8_t byte, steno_stroke_t *stroke)
+{
+  int group = byte >> 6;
+  bool done = false;
+
+  // A group at or before the last one starts the next stroke
+  if (d->group >= 0 && group <= d->group)
+  {
+    *stroke = d->keys;
+    done = d->keys != 0;
+    d->keys = 0;
+  }
+  d->group = group;
+  for (int bit = 0; bit < 6; bit++)
+  {
+    if (byte & (1 << bit))
+    {
+      if (group == 3 && bit == 5)
+      {
+        d->errors++;
+        continue;
+      }
+      d->keys |= BIT(bolt_chart[group][bit]);
+    }
+  }
+  return done;
+}
+
+bool steno_decode(steno_decoder_t *d, uint8_t byte, steno_stroke_t *stroke)
+{
+  return d->protocol == STENO_BOLT ? decode_bolt(d, byte, stroke) : decode_gemini(d, byte, stroke);
+}
+
+steno_stroke_t steno_bolt_keys(steno_stroke_t stroke)
+{
+  steno_stroke_t keys = 0;
+
+  for (int group = 0; group < 4; group++)
+  {
+    for (int bit = 0; bit < 6 && (group < 3 || bit < 5); bit++)
+    {
+      keys |= stroke & BIT(bolt_chart[group][bit]);
+    }
+  }
+  if (stroke & BIT(8))
+  {
+    keys |= BIT(7);
+  }
+  if (stroke & STARS)
+  {
+    keys = (keys & ~STARS) | BIT(17);
+  }
+  if (stroke & NUMBERS)
+  {
+    keys = (keys & ~NUMBERS) | BIT(1);
+  }
+  return keys;
+}
+
+const char *steno_stroke_str(steno_stroke_t stroke, char *buf, size_t len)
+{
+  static const struct
+  {
+    char c;
+    steno_stroke_t keys;
+  } order[] = {
+          {'#', NUMBERS}, {'S', BIT(7) | BIT(8)}, {'T', BIT(9)}, {'K', BIT(10)},
+          {'P', BIT(11)}, {'W', BIT(12)}, {'H', BIT(13)}, {'R', BIT(14)},
+          {'A', BIT(15)}, {'O', BIT(16)}, {'*', STARS}, {'E', BIT(24)},
+          {'U', BIT(25)}, {'F', BIT(26)}, {'R', BIT(27)}, {'P', BIT(28)},
+          {'B', BIT(29)}, {'L', BIT(30)}, {'G', BIT(31)}, {'T', BIT(32)},
+          {'S', BIT(33)}, {'D', BIT(34)}, {'Z', BIT(41)},
+  };
+  size_t n = 0;
+
+  for (size_t i = 0; i < sizeof(order) / sizeof(order[0]) && n + 1 < len; i++)
+  {
+    if (order[i].keys == BIT(26) && !(stroke & MIDDLE) && (stroke & RIGHT))
+    {
+      buf[n++] = '-';
+    }
+    if (stroke & order[i].keys && n + 1 < len)
+    {
+      buf[n++] = order[i].c;
+    }
+  }
+  for (int key = 0; key < STENO_KEYS; key++)
+  {
+    size_t name = strlen(steno_key_names[key]);
+    if (stroke & EXTRAS & BIT(key) && n + name + 2 <= len)
+    {
+      buf[n++] = ' ';
+      memcpy(buf + n, steno_key_names[key], name);
+      n += name;
+    }
+  }
+  buf[n] = '\0';
+  return buf;
+}
@@ -0,0 +1,52 @@
+#ifndef STENO_PROTO_H
+#define STENO_PROTO_H
+
+/* Decodes the steno serial protocols the keymaps' steno.c sends, the way
+ * Plover's GeminiPR and TX Bolt machines read them. Shared by steno_decode
+ * and steno_check.
+ *
+ * A stroke is a bit per key in GeminiPR packet order, Fn first and -Z
+ * last. TX Bolt strokes use the same bits, each shared key on its first:
+ * S1-, *1 and #1.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define STENO_KEYS 42
+
+typedef uint64_t steno_stroke_t;
+
+typedef enum
+{
+  STENO_GEMINI,
+  STENO_BOLT,
+} steno_protocol_t;
+
+typedef struct
+{
+  steno_protocol_t protocol;
+  uint8_t packet[6]; // GeminiPR bytes so far
+  uint8_t length;
+  int group;         // TX Bolt group of the last byte, -1 at a stroke start
+  steno_stroke_t keys;
+  unsigned errors;   // bytes that don't fit the protocol, dropped
+} steno_decoder_t;
+
+// Key names in bit order, as Plover's GeminiPR driver gives them
+extern const char *const steno_key_names[STENO_KEYS];
+
+void steno_decoder_init(steno_decoder_t *d, steno_protocol_t protocol);
+
+// Returns true when byte completes a stroke with keys in it
+bool steno_decode(steno_decoder_t *d, uint8_t byte, steno_stroke_t *stroke);
+
+// What a stroke becomes over TX Bolt: shared keys merged, the rest dropped
+steno_stroke_t steno_bolt_keys(steno_stroke_t stroke);
+
+// Steno order, "#STKPWHRAO*EUFRPBLGTSDZ", a '-' where the vowels would
+// separate the hands, and any key outside that after a space
+const char *steno_stroke_str(steno_stroke_t stroke, char *buf, size_t len);
+
+#endif
@@ -0,0 +1,407 @@
+/* Cost of Unicode output per input method
+ *
+ *   unicode_cost [-p poll_ms] [-l] keymap.so [hex code point ...]
+ *
+ * Sends each code point through the keymap's uni_send() for every input
+ * method and reports how many keyboard reports it took and how long those
+ * take to reach the host when each report waits for its own USB poll (-p,
+ * 1ms for the NKRO endpoint, 10ms for the boot keyboard one). The reports
+ * are also fed through a model of the host input method to check they
+ * spell the character that was asked for and leave NumLock as it was: off,
+ * or on with -l. Alt codes above U+00FF are read the way RichEdit
+ * programs do.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "sim.h"
+
+// Same order as unicode_input.h
+enum
+{
+  UNI_WIN_ALTCODE = 0,
+  UNI_WIN_HEX,
+  UNI_WINCOMPOSE,
+  UNI_OSX,
+  UNI_LINUX,
+  UNI_COUNT,
+};
+
+static const char *const method_names[UNI_COUNT] = {"altcode", "winhex", "wincomp", "osx", "lin"};
+
+static const uint32_t default_points[] = {0x00E4, 0x00C4, 0x00DF, 0x00E9, 0x20AC, 0x2192, 0x1F600};
+
+/* Host side: turns reports back into key presses and runs them through
+ * the input method the OS would use.
+ */
+
+static const sim_board_t *board;
+
+typedef struct
+{
+  uint8_t method;
+  report_keyboard_t prev;
+  unsigned reports;
+
+  // Compose / dead key state
+  bool alt_only; // RAlt went down with nothing else yet
+  uint8_t compose[4];
+  uint8_t compose_len;
+  bool composing;
+  bool dead_umlaut;
+
+  // Hex entry
+  bool hex;
+  uint32_t value;
+  uint16_t units[2];
+  uint8_t nunits;
+  uint8_t digits;
+
+  // Alt + numpad entry
+  bool numlock;
+  bool leading_zero;
+
+  uint32_t out[4];
+  uint8_t nout;
+} host_t;
+
+static int hex_value(uint8_t key)
+{
+  if (key >= KC_1 && key <= KC_9)
+  {
+    return key - KC_1 + 1;
+  }
+  if (key == KC_0)
+  {
+    return 0;
+  }
+  if (key >= KC_A && key <= KC_F)
+  {
+    return key - KC_A + 10;
+  }
+  return -1;
+}
+
+static int keypad_value(uint8_t key)
+{
+  if (key >= KC_KP_1 && key <= KC_KP_9)
+  {
+    return key - KC_KP_1 + 1;
+  }
+  return key == KC_KP_0 ? 0 : -1;
+}
+
+static void emit(host_t *h, uint32_t cp)
+{
+  if (h->nout < 4)
+  {
+    h->out[h->nout++] = cp;
+  }
+}
+
+static uint32_t umlaut(uint8_t key, bool shift)
+{
+  uint32_t base = key == KC_A ? 0xE4 : key == KC_O ? 0xF6 : key == KC_U ? 0xFC : 0;
+  return base && shift ? base - 0x20 : base;
+}
+
+static void finish_compose(host_t *h)
+{
+  const uint8_t *c = h->compose;
+  if (h->compose_len == 3 && c[0] == KC_QUOT)
+  {
+    emit(h, umlaut(c[1], c[2]));
+    h->composing = false;
+  }
+  else if (h->compose_len == 2 && c[0] == KC_S && c[1] == KC_S)
+  {
+    emit(h, 0xDF);
+    h->composing = false;
+  }
+}
+
+static bool numpad_method(const host_t *h)
+{
+  return h->method == UNI_WIN_ALTCODE || h->method == UNI_WIN_HEX;
+}
+
+/* Windows reads Alt + numpad itself: a decimal code, or with numpad + and
+ * EnableHexNumpad a hex one, both typed out when Alt goes up. The numpad
+ * only gives digits with NumLock on.
+ */
+static void numpad_key_down(host_t *h, uint8_t key, uint8_t mods)
+{
+  if (key == KC_NLCK)
+  {
+    h->numlock = !h->numlock;
+    board->set_leds(h->numlock ? 1 << USB_LED_NUM_LOCK : 0);
+    return;
+  }
+  if (!(mods & MOD_BIT(KC_LALT)))
+  {
+    return;
+  }
+  int d = h->numlock ? keypad_value(key) : -1;
+  if (h->method == UNI_WIN_HEX)
+  {
+    if (key == KC_KP_PLUS)
+    {
+      h->hex = true;
+      h->value = 0;
+    }
+    else if (h->hex && (d >= 0 || (key >= KC_A && key <= KC_F)))
+    {
+      h->value = h->value << 4 | (d >= 0 ? d : key - KC_A + 10);
+    }
+  }
+  else if (d >= 0)
+  {
+    h->leading_zero |= !h->digits && !d;
+    h->value = h->value * 10 + d;
+    h->digits++;
+  }
+}
+
+static void numpad_alt_up(host_t *h)
+{
+  if (h->method == UNI_WIN_HEX && h->hex)
+  {
+    emit(h, h->value);
+  }
+  else if (h->method == UNI_WIN_ALTCODE && h->digits)
+  {
+    // Code page 1252 with the leading 0; it matches Latin-1 where it's used
+    emit(h, h->leading_zero ? h->value & 0xFF : h->value);
+  }
+  h->hex = false;
+  h->value = 0;
+  h->digits = 0;
+  h->leading_zero = false;
+}
+
+static void key_down(host_t *h, uint8_t key, uint8_t mods)
+{
+  bool shift = mods & (MOD_BIT(KC_LSFT) | MOD_BIT(KC_RSFT));
+  int d = hex_value(key);
+
+  h->alt_only = false;
+  if (numpad_method(h))
+  {
+    numpad_key_down(h, key, mods);
+    return;
+  }
+  if (h->hex && h->method != UNI_OSX)
+  {
+    if (d >= 0)
+    {
+      h->value = h->value << 4 | d;
+    }
+    else if ((h->method == UNI_LINUX && key == KC_SPC) || (h->method == UNI_WINCOMPOSE && key == KC_ENT))
+    {
+      emit(h, h->value);
+      h->hex = false;
+    }
+    return;
+  }
+  if (h->method == UNI_OSX)
+  {
+    if ((mods & MOD_BIT(KC_LALT)) && d >= 0)
+    {
+      h->value = h->value << 4 | d;
+      if (++h->digits == 4)
+      {
+        h->units[h->nunits++ & 1] = h->value;
+        h->value = 0;
+        h->digits = 0;
+      }
+    }
+    else if ((mods & MOD_BIT(KC_RALT)) && (mods & MOD_BIT(KC_RSFT)) && key == KC_SCLN)
+    {
+      h->dead_umlaut = true;
+    }
+    else if ((mods & MOD_BIT(KC_RALT)) && key == KC_S)
+    {
+      emit(h, 0xDF);
+    }
+    else if (h->dead_umlaut)
+    {
+      emit(h, umlaut(key, shift));
+      h->dead_umlaut = false;
+    }
+    return;
+  }
+  if (h->composing)
+  {
+    if (h->compose_len == 0 && key == KC_U && h->method == UNI_WINCOMPOSE)
+    {
+      h->composing = false;
+      h->hex = true;
+      h->value = 0;
+      return;
+    }
+    if (key == KC_QUOT && !shift)
+    {
+      key = 0; // only '"' starts an umlaut
+    }
+    h->compose[h->compose_len++] = key;
+    if (h->compose_len == 2 && h->compose[0] == KC_QUOT)
+    {
+      h->compose[h->compose_len++] = shift;
+    }
+    finish_compose(h);
+    if (h->compose_len >= 3)
+    {
+      h->composing = false;
+    }
+    return;
+  }
+  if (h->method == UNI_LINUX && key == KC_U && (mods & MOD_BIT(KC_LCTL)) && shift)
+  {
+    h->hex = true;
+    h->value = 0;
+  }
+}
+
+static void host_report(void *ctx, const report_keyboard_t *r)
+{
+  host_t *h = ctx;
+  uint8_t ralt = MOD_BIT(KC_RALT);
+
+  h->reports++;
+  if ((r->mods & ralt) && !(h->prev.mods & ralt))
+  {
+    h->alt_only = true;
+  }
+  // The modifier byte leads the report, so hosts apply it first
+  if (!(r->mods & ralt) && (h->prev.mods & ralt) && h->alt_only)
+  {
+    // A bare RAlt tap is the compose key
+    h->composing = h->method != UNI_OSX;
+    h->compose_len = 0;
+    h->alt_only = false;
+  }
+  for (int code = 0; code < 256; code++)
+  {
+    uint8_t bit = 1 << (code & 7);
+    if ((r->bits[code >> 3] & bit) && !(h->prev.bits[code >> 3] & bit))
+    {
+      key_down(h, code, r->mods);
+    }
+  }
+  if (numpad_method(h) && !(r->mods & MOD_BIT(KC_LALT)) && (h->prev.mods & MOD_BIT(KC_LALT)))
+  {
+    numpad_alt_up(h);
+  }
+  if (h->method == UNI_OSX && !(r->mods & MOD_BIT(KC_LALT)) && (h->prev.mods & MOD_BIT(KC_LALT)))
+  {
+    if (h->nunits == 1)
+    {
+      emit(h, h->units[0]);
+    }
+    else if (h->nunits == 2)
+    {
+      emit(h, 0x10000 + ((h->units[0] - 0xD800) << 10) + (h->units[1] - 0xDC00));
+    }
+    h->nunits = 0;
+  }
+  h->prev = *r;
+}
+
+static void utf8(uint32_t cp, char *buf)
+{
+  if (cp < 0x80)
+  {
+    sprintf(buf, "%c", (int)cp);
+  }
+  else if (cp < 0x800)
+  {
+    sprintf(buf, "%c%c", 0xC0 | cp >> 6, 0x80 | (cp & 0x3F));
+  }
+  else if (cp < 0x10000)
+  {
+    sprintf(buf, "%c%c%c", 0xE0 | cp >> 12, 0x80 | (cp >> 6 & 0x3F), 0x80 | (cp & 0x3F));
+  }
+  else
+  {
+    sprintf(buf, "%c%c%c%c", 0xF0 | cp >> 18, 0x80 | (cp >> 12 & 0x3F), 0x80 | (cp >> 6 & 0x3F),
+            0x80 | (cp & 0x3F));
+  }
+}
+
+int main(int argc, char **argv)
+{
+  double poll_ms = 1;
+  bool numlock = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:l")) != -1)
+  {
+    switch (opt)
+    {
+    case 'p':
+      poll_ms = atof(optarg);
+      break;
+    case 'l':
+      numlock = true;
+      break;
+    default:
+      fprintf(stderr, "usage: unicode_cost [-p poll_ms] [-l] keymap.so [hex code point ...]\n");
+      return 2;
+    }
+  }
+  if (optind >= argc)
+  {
+    fprintf(stderr, "usage: unicode_cost [-p poll_ms] [-l] keymap.so [hex code point ...]\n");
+    return 2;
+  }
+
+  board = sim_load(argv[optind]);
+  if (!board->unicode_send)
+  {
+    fprintf(stderr, "%s: keymap has no unicode_input.c\n", argv[optind]);
+    return 2;
+  }
+
+  uint32_t points[64];
+  int npoints = 0;
+  for (int i = optind + 1; i < argc && npoints < 64; i++)
+  {
+    points[npoints++] = strtoul(argv[i], NULL, 16);
+  }
+  if (!npoints)
+  {
+    for (size_t i = 0; i < sizeof(default_points) / sizeof(default_points[0]); i++)
+    {
+      points[npoints++] = default_points[i];
+    }
+  }
+
+  host_t host;
+  board->set_report_hook(host_report, &host);
+  board->init();
+
+  int failures = 0;
+  printf("%-8s %-7s %7s %9s  %s\n", "char", "method", "reports", "ms", "host saw");
+  for (int i = 0; i < npoints; i++)
+  {
+    char name[8];
+    utf8(points[i], name);
+    for (uint8_t method = 0; method < UNI_COUNT; method++)
+    {
+      host = (host_t){.method = method, .numlock = numlock};
+      board->set_leds(numlock ? 1 << USB_LED_NUM_LOCK : 0);
+      board->unicode_send(method, points[i]);
+      bool ok = host.nout == 1 && host.out[0] == points[i] && host.numlock == numlock;
+      char seen[8] = "-";
+      if (host.nout)
+      {
+        utf8(host.out[0], seen);
+      }
+      printf("U+%04X %s %-7s %7u %9.1f  %s%s\n", points[i], name, method_names[method], host.reports,
+             host.reports * poll_ms, seen, ok ? "" : "  MISMATCH");
+      failures += !ok;
+    }
+  }
+  return failures ? 1 : 0;
+}